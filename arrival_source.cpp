@@ -0,0 +1,53 @@
+#include "arrival_source.h"
+#include "workload_file.h"
+#include <utility>
+
+TableArrivalSource::TableArrivalSource(const ProcessTable& table)
+    : table(table), row(0) {}
+
+bool TableArrivalSource::next(Process& process) {
+    if (row >= table.size()) {
+        return false;
+    }
+    
+    uint32_t pid = static_cast<uint32_t>(row++);
+    process = Process(table.name(pid), table.arrival[pid], table.burst[pid], 
+                      table.priority[pid], table.deadline[pid]);
+    return true;
+}
+
+CsvArrivalSource::CsvArrivalSource(const string& filePath) : reader(filePath) {}
+
+bool CsvArrivalSource::next(Process& process) {
+    return reader.next(process);
+}
+
+WorkloadFileArrivalSource::WorkloadFileArrivalSource(const string& filePath)
+    : file(new WorkloadFile(filePath)), row(0) {}
+
+WorkloadFileArrivalSource::~WorkloadFileArrivalSource() = default;
+
+bool WorkloadFileArrivalSource::next(Process& process) {
+    if (row >= file->size()) {
+        return false;
+    }
+    
+    process = Process(file->name(row), file->arrival()[row], file->burst()[row], 
+                      file->priority()[row], file->deadline()[row]);
+    row++;
+    return true;
+}
+
+GeneratorArrivalSource::GeneratorArrivalSource(function<bool(Process&)> generate)
+    : generate(move(generate)) {}
+
+bool GeneratorArrivalSource::next(Process& process) {
+    return generate(process);
+}
+
+unique_ptr<ArrivalSource> openArrivalSource(const string& filePath) {
+    if (WorkloadFile::isWorkloadFile(filePath)) {
+        return unique_ptr<ArrivalSource>(new WorkloadFileArrivalSource(filePath));
+    }
+    return unique_ptr<ArrivalSource>(new CsvArrivalSource(filePath));
+}
@@ -0,0 +1,126 @@
+#ifndef ARRIVAL_SOURCE_H
+#define ARRIVAL_SOURCE_H
+
+#include <string>
+#include <memory>
+#include <functional>
+#include <cstddef>
+#include "process.h"
+#include "process_table.h"
+#include "csv_reader.h"
+
+using namespace std;
+
+/**
+ * @class ArrivalSource
+ * @brief Lazily produces processes in non-decreasing arrival order
+ * 
+ * Streaming runs pull from a source one process at a time, so the whole
+ * workload never has to be held in memory.
+ */
+class ArrivalSource {
+public:
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~ArrivalSource() = default;
+    
+    /**
+     * @brief Produces the next process
+     * @param process Receives the next process
+     * @return False once the source is exhausted
+     */
+    virtual bool next(Process& process) = 0;
+};
+
+/**
+ * @class TableArrivalSource
+ * @brief Streams the rows of an in-memory process table
+ */
+class TableArrivalSource : public ArrivalSource {
+private:
+    const ProcessTable& table;  // Rows to stream, already in arrival order
+    size_t row;                 // Next row to produce
+
+public:
+    /**
+     * @brief Constructor for TableArrivalSource
+     * @param table Table to stream; must outlive the source
+     */
+    explicit TableArrivalSource(const ProcessTable& table);
+    
+    bool next(Process& process) override;
+};
+
+/**
+ * @class CsvArrivalSource
+ * @brief Streams processes from a workload CSV without loading it
+ * 
+ * The file must already be sorted by arrival time.
+ */
+class CsvArrivalSource : public ArrivalSource {
+private:
+    CsvProcessReader reader;  // Incremental reader over the mapped file
+
+public:
+    /**
+     * @brief Constructor for CsvArrivalSource
+     * @param filePath Path to the CSV file
+     */
+    explicit CsvArrivalSource(const string& filePath);
+    
+    bool next(Process& process) override;
+};
+
+class WorkloadFile;
+
+/**
+ * @class WorkloadFileArrivalSource
+ * @brief Streams processes from a memory-mapped binary workload file
+ */
+class WorkloadFileArrivalSource : public ArrivalSource {
+private:
+    unique_ptr<WorkloadFile> file;  // Mapped file
+    size_t row;                     // Next row to produce
+
+public:
+    /**
+     * @brief Constructor for WorkloadFileArrivalSource
+     * @param filePath Path to the binary workload file
+     */
+    explicit WorkloadFileArrivalSource(const string& filePath);
+    
+    /**
+     * @brief Destructor; unmaps the file
+     */
+    ~WorkloadFileArrivalSource() override;
+    
+    bool next(Process& process) override;
+};
+
+/**
+ * @class GeneratorArrivalSource
+ * @brief Streams processes produced on the fly by a callback
+ */
+class GeneratorArrivalSource : public ArrivalSource {
+private:
+    function<bool(Process&)> generate;  // Fills the next process, false when done
+
+public:
+    /**
+     * @brief Constructor for GeneratorArrivalSource
+     * @param generate Callback with the same contract as next()
+     */
+    explicit GeneratorArrivalSource(function<bool(Process&)> generate);
+    
+    bool next(Process& process) override;
+};
+
+/**
+ * @brief Opens a streaming source for a CSV or binary workload file
+ * @param filePath Path to the file
+ * @return Source matching the file's format
+ */
+unique_ptr<ArrivalSource> openArrivalSource(const string& filePath);
+
+#endif // ARRIVAL_SOURCE_H
@@ -0,0 +1,193 @@
+#include "batch_runner.h"
+#include "process_loader.h"
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <glob.h>
+#include <sys/stat.h>
+#endif
+
+namespace {
+    bool isWorkloadExtension(const string& path) {
+        size_t dot = path.rfind('.');
+        if (dot == string::npos) {
+            return false;
+        }
+        string extension = path.substr(dot);
+        transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        return extension == ".csv" || extension == ".bin";
+    }
+    
+    // Expands a wildcard pattern; a directory expands to everything in it
+    vector<string> expand(const string& pattern, bool& isDirectory) {
+        vector<string> paths;
+#ifdef _WIN32
+        DWORD attributes = GetFileAttributesA(pattern.c_str());
+        isDirectory = attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY);
+        string search = isDirectory ? pattern + "\\*" : pattern;
+        
+        size_t slash = search.find_last_of("\\/");
+        string folder = slash == string::npos ? "" : search.substr(0, slash + 1);
+        WIN32_FIND_DATAA entry;
+        HANDLE handle = FindFirstFileA(search.c_str(), &entry);
+        if (handle != INVALID_HANDLE_VALUE) {
+            do {
+                if (!(entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+                    paths.push_back(folder + entry.cFileName);
+                }
+            } while (FindNextFileA(handle, &entry));
+            FindClose(handle);
+        }
+#else
+        struct stat info;
+        isDirectory = stat(pattern.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+        string search = isDirectory ? pattern + "/*" : pattern;
+        
+        glob_t matches;
+        if (glob(search.c_str(), 0, nullptr, &matches) == 0) {
+            for (size_t i = 0; i < matches.gl_pathc; i++) {
+                struct stat entry;
+                if (stat(matches.gl_pathv[i], &entry) == 0 && S_ISREG(entry.st_mode)) {
+                    paths.push_back(matches.gl_pathv[i]);
+                }
+            }
+        }
+        globfree(&matches);
+#endif
+        return paths;
+    }
+}
+
+BatchRunner::BatchRunner(size_t threads, size_t maxInFlight)
+    : cpus(1), queueMode(PER_CPU_QUEUES), maxInFlight(maxInFlight), pool(threads) {
+    if (this->maxInFlight == 0) {
+        this->maxInFlight = 2 * pool.size();
+    }
+}
+
+void BatchRunner::add(SchedulerFactory factory) {
+    algorithms.push_back(move(factory));
+}
+
+void BatchRunner::addDefaultAlgorithms(int timeQuantum) {
+    for (auto& factory : defaultAlgorithms(timeQuantum)) {
+        add(move(factory));
+    }
+}
+
+void BatchRunner::setCpus(size_t count, QueueMode mode) {
+    if (count < 1) {
+        throw invalid_argument("A batch needs at least one CPU");
+    }
+    cpus = count;
+    queueMode = mode;
+}
+
+BatchFileResult BatchRunner::runFile(const string& path) const {
+    BatchFileResult result;
+    result.path = path;
+    
+    try {
+        result.workload = ProcessLoader::loadTable(path);
+        const ProcessTable& workload = result.workload;
+        if (workload.size() == 0) {
+            throw runtime_error("No processes in file");
+        }
+        
+        // The file is the unit of parallelism, so its algorithms run in turn
+        result.entries.resize(algorithms.size());
+        for (size_t i = 0; i < algorithms.size(); i++) {
+            unique_ptr<Scheduler> scheduler = algorithms[i](workload);
+            scheduler->setCpus(cpus, queueMode);
+            result.entries[i].algorithmName = scheduler->getName();
+            result.entries[i].result = scheduler->run();
+            
+            // Only the metrics are reported, so the charts and per-process
+            // times need not wait in memory
+            result.entries[i].result.ganttChart = vector<GanttSegment>();
+            result.entries[i].result.cpus = vector<CpuTrack>();
+            result.entries[i].result.completions = vector<int>();
+            result.entries[i].result.responses = vector<int>();
+        }
+    } catch (const exception& e) {
+        result.workload = ProcessTable();
+        result.entries.clear();
+        result.error = e.what();
+    }
+    return result;
+}
+
+size_t BatchRunner::run(const vector<string>& files, const function<void(const BatchFileResult&)>& consume) {
+    mutex lock;                         // Guards finished
+    condition_variable fileDone;        // Signalled when a file is added to finished
+    map<size_t, BatchFileResult> finished;  // Files done but not yet reported, by index
+    
+    size_t submitted = 0;
+    size_t reported = 0;
+    size_t failures = 0;
+    
+    while (reported < files.size()) {
+        // Keep the pipeline full, then report whatever is ready in order
+        while (submitted < files.size() && submitted - reported < maxInFlight) {
+            size_t index = submitted++;
+            pool.submit([this, index, &files, &lock, &fileDone, &finished] {
+                BatchFileResult result = runFile(files[index]);
+                
+                // Notify under the lock: once it is released the caller may
+                // report this file and return
+                lock_guard<mutex> guard(lock);
+                finished[index] = move(result);
+                fileDone.notify_one();
+            });
+        }
+        
+        BatchFileResult next;
+        {
+            unique_lock<mutex> guard(lock);
+            fileDone.wait(guard, [&finished, reported] {
+                return !finished.empty() && finished.begin()->first == reported;
+            });
+            next = move(finished.begin()->second);
+            finished.erase(finished.begin());
+        }
+        
+        if (!next.error.empty()) {
+            failures++;
+        }
+        try {
+            consume(next);
+        } catch (...) {
+            // Tasks still in flight refer to this frame
+            pool.wait();
+            throw;
+        }
+        reported++;
+    }
+    
+    return failures;
+}
+
+vector<string> BatchRunner::findWorkloads(const string& pattern) {
+    bool isDirectory = false;
+    vector<string> paths = expand(pattern, isDirectory);
+    if (isDirectory) {
+        paths.erase(remove_if(paths.begin(), paths.end(),
+                              [](const string& path) { return !isWorkloadExtension(path); }),
+                    paths.end());
+    }
+    sort(paths.begin(), paths.end());
+    
+    if (paths.empty()) {
+        throw runtime_error("No workload files match " + pattern);
+    }
+    return paths;
+}
@@ -0,0 +1,92 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <vector>
+#include <string>
+#include <functional>
+#include "scheduler.h"
+#include "comparison_runner.h"
+#include "thread_pool.h"
+
+using namespace std;
+
+/**
+ * @struct BatchFileResult
+ * @brief Results of every algorithm on one workload file of a batch
+ */
+struct BatchFileResult {
+    string path;                       // Workload file
+    ProcessTable workload;             // Processes in the file, for the result writer
+    vector<ComparisonEntry> entries;   // One entry per algorithm; Gantt charts and per-process times are dropped
+    string error;                      // Why the file failed, empty on success
+};
+
+/**
+ * @class BatchRunner
+ * @brief Simulates many workload files in parallel with a bounded number in flight
+ * 
+ * Each file is loaded and run through every algorithm by one pool task, so
+ * one file's loading overlaps other files' simulation. At most maxInFlight
+ * files are loaded or waiting to be reported at a time, which bounds memory
+ * whatever the number of files. Results are handed back on the calling
+ * thread in input order as soon as each file and all files before it are
+ * done.
+ */
+class BatchRunner {
+private:
+    vector<SchedulerFactory> algorithms;  // Algorithms run on every file, in output order
+    size_t cpus;                          // Simulated CPUs in every run
+    QueueMode queueMode;                  // How those CPUs share ready processes
+    size_t maxInFlight;                   // Files loaded but not yet reported
+    ThreadPool pool;                      // Workers that load and simulate files
+    
+    BatchFileResult runFile(const string& path) const;
+
+public:
+    /**
+     * @brief Constructor for BatchRunner
+     * @param threads Number of worker threads, or 0 for one per hardware thread
+     * @param maxInFlight Files in flight at once, or 0 for twice the thread count
+     */
+    explicit BatchRunner(size_t threads = 0, size_t maxInFlight = 0);
+    
+    /**
+     * @brief Adds an algorithm to run on every file
+     * @param factory Builds the algorithm's scheduler for a workload
+     */
+    void add(SchedulerFactory factory);
+    
+    /**
+     * @brief Adds the ten algorithms of the interactive menu
+     * @param timeQuantum Time quantum for Round Robin, and the top-level quantum of MLFQ
+     */
+    void addDefaultAlgorithms(int timeQuantum = 2);
+    
+    /**
+     * @brief Sets the simulated CPUs every run uses
+     * @param count Number of CPUs, at least 1
+     * @param mode Whether the CPUs share one ready queue or each have their own
+     */
+    void setCpus(size_t count, QueueMode mode);
+    
+    /**
+     * @brief Simulates a list of workload files
+     * @param files Workload files, CSV or binary
+     * @param consume Called on the calling thread with each file's results, in input order
+     * @return Number of files that failed to load or run
+     * 
+     * A file that fails is reported with its error and does not stop the batch.
+     */
+    size_t run(const vector<string>& files, const function<void(const BatchFileResult&)>& consume);
+    
+    /**
+     * @brief Lists the workload files matching a directory or a glob pattern
+     * @param pattern A directory, whose .csv and .bin files are taken, or a wildcard pattern
+     * @return Matching files, sorted by path
+     * 
+     * Throws runtime_error if nothing matches.
+     */
+    static vector<string> findWorkloads(const string& pattern);
+};
+
+#endif // BATCH_RUNNER_H
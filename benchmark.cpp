@@ -0,0 +1,440 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include <new>
+#include <cstdlib>
+#include <cstdint>
+
+#ifdef _WIN32
+#define PSAPI_VERSION 2
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "process_table.h"
+#include "workload_generator.h"
+#include "fcfs_scheduler.h"
+#include "sjf_scheduler.h"
+#include "rr_scheduler.h"
+#include "priority_scheduler.h"
+#include "ljf_scheduler.h"
+#include "hrrn_scheduler.h"
+#include "mlfq_scheduler.h"
+#include "indexed_heap.h"
+#include "scratch_arena.h"
+
+using namespace std;
+
+// Times Scheduler::run() for every algorithm on generated workloads of
+// increasing size and arrival density, and writes one CSV row per run.
+// Each scheduler is run repeatedly with its result recycled, the way a
+// sweep reuses it, so the allocation columns show what a steady-state run
+// costs once the thread's scratch arena has grown to size: nothing.
+
+// Every allocation carries a small header with its size, so live and peak
+// heap bytes can be tracked alongside the number of calls
+namespace {
+    const size_t HEADER = 16;  // Keeps the returned block 16-byte aligned
+    
+    atomic<uint64_t> allocationCount(0);
+    atomic<uint64_t> allocatedBytes(0);
+    atomic<int64_t> liveBytes(0);
+    atomic<int64_t> peakLiveBytes(0);
+    
+    void* countedAlloc(size_t size) {
+        void* block = malloc(size + HEADER);
+        if (block == nullptr) {
+            return nullptr;
+        }
+        *static_cast<size_t*>(block) = size;
+        
+        allocationCount.fetch_add(1, memory_order_relaxed);
+        allocatedBytes.fetch_add(size, memory_order_relaxed);
+        int64_t live = liveBytes.fetch_add(size, memory_order_relaxed) + size;
+        int64_t peak = peakLiveBytes.load(memory_order_relaxed);
+        while (live > peak && !peakLiveBytes.compare_exchange_weak(peak, live, memory_order_relaxed)) {
+        }
+        return static_cast<char*>(block) + HEADER;
+    }
+    
+    void countedFree(void* pointer) {
+        if (pointer == nullptr) {
+            return;
+        }
+        void* block = static_cast<char*>(pointer) - HEADER;
+        liveBytes.fetch_sub(*static_cast<size_t*>(block), memory_order_relaxed);
+        free(block);
+    }
+    
+    void* countedNew(size_t size) {
+        void* pointer = countedAlloc(size);
+        if (pointer == nullptr) {
+            throw bad_alloc();
+        }
+        return pointer;
+    }
+}
+
+void* operator new(size_t size) { return countedNew(size); }
+void* operator new[](size_t size) { return countedNew(size); }
+void* operator new(size_t size, const nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](size_t size, const nothrow_t&) noexcept { return countedAlloc(size); }
+void operator delete(void* pointer) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, const nothrow_t&) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer, const nothrow_t&) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, size_t) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { countedFree(pointer); }
+
+namespace {
+    // Peak resident set size of the whole process so far, in kilobytes
+    long peakRssKb() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return 0;
+        }
+        return static_cast<long>(counters.PeakWorkingSetSize / 1024);
+#else
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+#endif
+    }
+    
+    // Offered load is the mean burst time over the mean inter-arrival gap;
+    // loads above 1 keep a growing backlog
+    ProcessTable generateWorkload(size_t jobs, double load, uint64_t seed) {
+        WorkloadSpec spec;
+        spec.jobs = jobs;
+        spec.seed = seed;
+        spec.arrivals = POISSON_ARRIVALS;
+        spec.bursts = UNIFORM_BURSTS;
+        spec.minBurst = 1;
+        spec.maxBurst = 19;
+        spec.arrivalRate = load / 10.0;
+        return WorkloadGenerator::generateTable(spec);
+    }
+    
+    // Key of a process for DynamicPolicyScheduler, looked up at run time
+    typedef int (*KeyFunction)(uint32_t pid, const JobState& jobs, const ProcessTable& table);
+    
+    struct DynamicOrder {
+        KeyFunction key;
+        const JobState* jobs;
+        const ProcessTable* table;
+        
+        bool operator()(size_t a, size_t b) const {
+            int keyA = key(static_cast<uint32_t>(a), *jobs, *table);
+            int keyB = key(static_cast<uint32_t>(b), *jobs, *table);
+            if (keyA != keyB) {
+                return keyA < keyB;
+            }
+            return table->sequence[a] < table->sequence[b];
+        }
+    };
+    
+    // Baseline for PolicyScheduler the way the key schedulers used to be
+    // built: the key goes through a function pointer, preemption is a
+    // run-time flag and the event loop calls every hook virtually. Runs
+    // on one CPU schedule exactly as the compile-time versions do, so the
+    // "-dynamic" keys measure only what specializing them saves.
+    template <typename KeyPolicy>
+    class DynamicPolicyScheduler : public Scheduler {
+    private:
+        bool preemptive;
+        KeyFunction key;
+        vector<IndexedHeap<DynamicOrder>> readyQueues;
+    
+    public:
+        DynamicPolicyScheduler(const ProcessTable& table, bool preemptive)
+            : Scheduler(table), preemptive(preemptive), key(&KeyPolicy::key) {}
+        
+        string getName() const override {
+            return KeyPolicy::name(preemptive) + " [dynamic]";
+        }
+        
+        string getDescription() const override {
+            return KeyPolicy::description(preemptive);
+        }
+    
+    protected:
+        void resetReadyQueue(size_t capacity) override {
+            readyQueues.resize(readyQueueCount());
+            for (auto& readyQueue : readyQueues) {
+                readyQueue.reset(capacity, DynamicOrder{key, &jobs, table});
+            }
+        }
+        
+        void growReadyQueue(size_t capacity) override {
+            for (auto& readyQueue : readyQueues) {
+                readyQueue.grow(capacity);
+            }
+        }
+        
+        void enqueue(uint32_t pid, size_t queue) override {
+            readyQueues[queue].push(pid);
+        }
+        
+        uint32_t dequeue(size_t queue) override {
+            if (readyQueues[queue].empty()) {
+                return NO_PID;
+            }
+            return static_cast<uint32_t>(readyQueues[queue].pop());
+        }
+        
+        int sliceLength(uint32_t running, size_t queue) const override {
+            const auto& readyQueue = readyQueues[queue];
+            if (!preemptive || !KeyPolicy::RUNNING_KEY_GROWS || readyQueue.empty()) {
+                return jobs.remaining[running];
+            }
+            uint32_t best = static_cast<uint32_t>(readyQueue.top());
+            int gap = key(best, jobs, *table) - key(running, jobs, *table);
+            return table->sequence[best] < table->sequence[running] ? gap : gap + 1;
+        }
+        
+        bool preemptsOnArrival() const override {
+            return preemptive;
+        }
+        
+        bool shouldPreempt(uint32_t running, size_t queue) const override {
+            const auto& readyQueue = readyQueues[queue];
+            if (!preemptive || readyQueue.empty()) {
+                return false;
+            }
+            uint32_t best = static_cast<uint32_t>(readyQueue.top());
+            if (KeyPolicy::FIXED_KEY) {
+                return key(best, jobs, *table) < key(running, jobs, *table);
+            }
+            return DynamicOrder{key, &jobs, table}(best, running);
+        }
+    };
+    
+    struct Algorithm {
+        string key;
+        function<unique_ptr<Scheduler>(const ProcessTable&, int)> create;
+    };
+    
+    vector<Algorithm> allAlgorithms() {
+        return {
+            {"fcfs", [](const ProcessTable& t, int) { return unique_ptr<Scheduler>(new FCFSScheduler(t)); }},
+            {"sjf", [](const ProcessTable& t, int) { return unique_ptr<Scheduler>(new SJFScheduler(t)); }},
+            {"srtf", [](const ProcessTable& t, int) { return unique_ptr<Scheduler>(new SRTFScheduler(t)); }},
+            {"rr", [](const ProcessTable& t, int q) { return unique_ptr<Scheduler>(new RRScheduler(t, q)); }},
+            {"priority", [](const ProcessTable& t, int) { return unique_ptr<Scheduler>(new PriorityScheduler(t)); }},
+            {"priority-preemptive", [](const ProcessTable& t, int) { return unique_ptr<Scheduler>(new PreemptivePriorityScheduler(t)); }},
+            {"ljf", [](const ProcessTable& t, int) { return unique_ptr<Scheduler>(new LJFScheduler(t)); }},
+            {"lrtf", [](const ProcessTable& t, int) { return unique_ptr<Scheduler>(new LRTFScheduler(t)); }},
+            {"hrrn", [](const ProcessTable& t, int) { return unique_ptr<Scheduler>(new HRRNScheduler(t)); }},
+            {"mlfq", [](const ProcessTable& t, int q) { return unique_ptr<Scheduler>(new MLFQScheduler(t, q)); }},
+        };
+    }
+    
+    // Run only when asked for by name, next to the keys they mirror
+    vector<Algorithm> dynamicAlgorithms() {
+        return {
+            {"sjf-dynamic", [](const ProcessTable& t, int) { return unique_ptr<Scheduler>(new DynamicPolicyScheduler<ShortestRemaining>(t, false)); }},
+            {"srtf-dynamic", [](const ProcessTable& t, int) { return unique_ptr<Scheduler>(new DynamicPolicyScheduler<ShortestRemaining>(t, true)); }},
+            {"priority-dynamic", [](const ProcessTable& t, int) { return unique_ptr<Scheduler>(new DynamicPolicyScheduler<HighestPriority>(t, false)); }},
+            {"priority-preemptive-dynamic", [](const ProcessTable& t, int) { return unique_ptr<Scheduler>(new DynamicPolicyScheduler<HighestPriority>(t, true)); }},
+            {"ljf-dynamic", [](const ProcessTable& t, int) { return unique_ptr<Scheduler>(new DynamicPolicyScheduler<LongestRemaining>(t, false)); }},
+            {"lrtf-dynamic", [](const ProcessTable& t, int) { return unique_ptr<Scheduler>(new DynamicPolicyScheduler<LongestRemaining>(t, true)); }},
+        };
+    }
+    
+    struct Options {
+        vector<size_t> sizes = {1000, 10000, 100000, 1000000, 10000000};
+        vector<double> loads = {0.5, 0.9, 1.5};
+        vector<string> algorithms;
+        int timeQuantum = 4;
+        uint64_t seed = 1;
+        string output = "bench_results.csv";
+        string label = "";
+    };
+    
+    vector<string> splitList(const string& text) {
+        vector<string> items;
+        stringstream stream(text);
+        string item;
+        while (getline(stream, item, ',')) {
+            items.push_back(item);
+        }
+        return items;
+    }
+    
+    void printUsage(const char* program) {
+        cerr << "Usage: " << program << " [--sizes 1000,10000,...] [--loads 0.5,0.9,1.5]\n"
+             << "       [--algorithms fcfs,sjf,srtf,rr,priority,priority-preemptive,ljf,lrtf,hrrn,mlfq]\n"
+             << "       (add sjf-dynamic, srtf-dynamic, ... to compare with dynamic dispatch)\n"
+             << "       [--quantum N] [--seed N] [--output results.csv] [--label TEXT]\n";
+    }
+    
+    bool parseOptions(int argc, char* argv[], Options& options) {
+        for (int i = 1; i < argc; i++) {
+            string option = argv[i];
+            if (i + 1 >= argc) {
+                cerr << "Missing value for " << option << "\n";
+                return false;
+            }
+            string value = argv[++i];
+            
+            try {
+                if (option == "--sizes") {
+                    options.sizes.clear();
+                    for (const auto& item : splitList(value)) {
+                        options.sizes.push_back(static_cast<size_t>(stod(item)));
+                    }
+                } else if (option == "--loads") {
+                    options.loads.clear();
+                    for (const auto& item : splitList(value)) {
+                        options.loads.push_back(stod(item));
+                    }
+                } else if (option == "--algorithms") {
+                    options.algorithms = splitList(value);
+                } else if (option == "--quantum") {
+                    options.timeQuantum = stoi(value);
+                } else if (option == "--seed") {
+                    options.seed = stoull(value);
+                } else if (option == "--output") {
+                    options.output = value;
+                } else if (option == "--label") {
+                    options.label = value;
+                } else {
+                    cerr << "Unknown option " << option << "\n";
+                    return false;
+                }
+            } catch (const exception&) {
+                cerr << "Invalid value for " << option << ": " << value << "\n";
+                return false;
+            }
+        }
+        
+        for (double load : options.loads) {
+            if (load <= 0) {
+                cerr << "Loads must be positive\n";
+                return false;
+            }
+        }
+        if (options.timeQuantum < 1) {
+            cerr << "Time quantum must be at least 1\n";
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    
+    vector<Algorithm> algorithms = allAlgorithms();
+    if (!options.algorithms.empty()) {
+        vector<Algorithm> known = algorithms;
+        vector<Algorithm> dynamic = dynamicAlgorithms();
+        known.insert(known.end(), dynamic.begin(), dynamic.end());
+        
+        vector<Algorithm> selected;
+        for (const auto& key : options.algorithms) {
+            auto match = find_if(known.begin(), known.end(),
+                                 [&key](const Algorithm& a) { return a.key == key; });
+            if (match == known.end()) {
+                cerr << "Unknown algorithm " << key << "\n";
+                printUsage(argv[0]);
+                return 2;
+            }
+            selected.push_back(*match);
+        }
+        algorithms = selected;
+    }
+    
+    ofstream csv(options.output);
+    if (!csv) {
+        cerr << "Error: Failed to open file: " << options.output << "\n";
+        return 1;
+    }
+    csv << "label,algorithm,jobs,load,seed,quantum,repeats,best_seconds,ns_per_job,"
+           "gantt_segments,allocations,allocated_bytes,peak_heap_bytes,arena_bytes,peak_rss_kb\n";
+    
+    cout << left << setw(28) << "Algorithm" << right << setw(10) << "Jobs" << setw(6) << "Load"
+         << setw(12) << "ns/job" << setw(12) << "Segments" << setw(10) << "Allocs"
+         << setw(14) << "Peak heap MB" << setw(10) << "Arena MB" << setw(13) << "Peak RSS MB" << "\n";
+    
+    for (size_t jobs : options.sizes) {
+        for (double load : options.loads) {
+            ProcessTable workload = generateWorkload(jobs, load, options.seed);
+            
+            for (const auto& algorithm : algorithms) {
+                // Small workloads are repeated so the timer has something to measure.
+                // The first run sizes the arena and the second merges its blocks,
+                // so the third is the first in steady state.
+                size_t repeats = max<size_t>(3, min<size_t>(50, 1000000 / max<size_t>(jobs, 1)));
+                
+                unique_ptr<Scheduler> scheduler = algorithm.create(workload, options.timeQuantum);
+                double best = 0;
+                size_t segments = 0;
+                uint64_t allocations = 0;
+                uint64_t bytes = 0;
+                int64_t peakHeap = 0;
+                
+                for (size_t r = 0; r < repeats; r++) {
+                    uint64_t countBefore = allocationCount.load();
+                    uint64_t bytesBefore = allocatedBytes.load();
+                    int64_t liveBefore = liveBytes.load();
+                    peakLiveBytes.store(liveBefore);
+                    
+                    auto start = chrono::steady_clock::now();
+                    SchedulerResult result = scheduler->run();
+                    auto end = chrono::steady_clock::now();
+                    
+                    double seconds = chrono::duration<double>(end - start).count();
+                    if (r == 0 || seconds < best) {
+                        best = seconds;
+                    }
+                    
+                    // Allocation figures come from the last, steady-state repetition
+                    segments = result.ganttChart.size();
+                    allocations = allocationCount.load() - countBefore;
+                    bytes = allocatedBytes.load() - bytesBefore;
+                    peakHeap = peakLiveBytes.load() - liveBefore;
+                    scheduler->recycle(move(result));
+                }
+                scheduler.reset();
+                
+                // Working memory is in the arena, not on the heap, once it has grown
+                size_t arenaBytes = ScratchArena::local().capacity();
+                double nsPerJob = best * 1e9 / max<size_t>(jobs, 1);
+                long rss = peakRssKb();
+                
+                csv << options.label << "," << algorithm.key << "," << jobs << "," << load << ","
+                    << options.seed << "," << options.timeQuantum << "," << repeats << ","
+                    << setprecision(9) << best << "," << setprecision(6) << nsPerJob << ","
+                    << segments << "," << allocations << "," << bytes << "," << peakHeap << ","
+                    << arenaBytes << "," << rss << "\n";
+                
+                cout << left << setw(28) << algorithm.key << right << setw(10) << jobs
+                     << setw(6) << load << fixed << setprecision(1) << setw(12) << nsPerJob
+                     << setw(12) << segments << setw(10) << allocations
+                     << setw(14) << peakHeap / 1048576.0 << setw(10) << arenaBytes / 1048576.0
+                     << setw(13) << rss / 1024.0 << "\n";
+                cout.unsetf(ios::fixed);
+                cout << setprecision(6) << flush;
+            }
+        }
+    }
+    
+    cout << "Results written to " << options.output << "\n";
+    return 0;
+}
@@ -11,7 +11,7 @@ if %ERRORLEVEL% neq 0 (
 )
 
 :: Compile the program
-g++ -std=c++11 -Wall -Wextra -o cpu_scheduler.exe main.cpp process.cpp scheduler.cpp fcfs_scheduler.cpp sjf_scheduler.cpp rr_scheduler.cpp priority_scheduler.cpp ljf_scheduler.cpp hrrn_scheduler.cpp process_loader.cpp
+g++ -std=c++11 -Wall -Wextra -pthread -o cpu_scheduler.exe main.cpp process.cpp process_table.cpp scheduler.cpp fcfs_scheduler.cpp sjf_scheduler.cpp rr_scheduler.cpp priority_scheduler.cpp ljf_scheduler.cpp hrrn_scheduler.cpp mlfq_scheduler.cpp process_loader.cpp csv_reader.cpp arrival_source.cpp mapped_file.cpp workload_file.cpp priority_run_queue.cpp response_ratio_tree.cpp thread_pool.cpp comparison_runner.cpp parameter_sweep.cpp workload_generator.cpp batch_runner.cpp replication_runner.cpp latency_histogram.cpp scheduler_stats.cpp result_writer.cpp scratch_arena.cpp
 
 if %ERRORLEVEL% neq 0 (
     echo Compilation failed.
@@ -0,0 +1,228 @@
+#include "comparison_runner.h"
+#include "fcfs_scheduler.h"
+#include "sjf_scheduler.h"
+#include "rr_scheduler.h"
+#include "priority_scheduler.h"
+#include "ljf_scheduler.h"
+#include "hrrn_scheduler.h"
+#include "mlfq_scheduler.h"
+#include <exception>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    // Parameters of an algorithm spec; each algorithm reads only its own
+    struct AlgorithmOptions {
+        int timeQuantum = 2;    // Round Robin quantum, and MLFQ's top-level quantum
+        vector<int> quanta;     // MLFQ quanta by level, or empty for the doubling default
+        int boostPeriod = -1;   // MLFQ boost period, or -1 for the default
+    };
+    
+    // An algorithm selectable by key
+    struct AlgorithmKey {
+        const char* key;
+        bool takesQuantum;
+        bool takesLevels;
+        Scheduler* (*create)(const ProcessTable& table, const AlgorithmOptions& options);
+    };
+    
+    // Fills in MLFQ's default levels and boost period; throws
+    // invalid_argument if either would not fit in an int
+    void resolveLevels(AlgorithmOptions& options) {
+        if (options.quanta.empty()) {
+            options.quanta = MLFQScheduler::doublingQuanta(options.timeQuantum);
+        }
+        if (options.boostPeriod < 0) {
+            options.boostPeriod = MLFQScheduler::defaultBoostPeriod(options.quanta);
+        }
+    }
+    
+    Scheduler* createMLFQ(const ProcessTable& table, const AlgorithmOptions& options) {
+        AlgorithmOptions levels = options;
+        resolveLevels(levels);
+        return new MLFQScheduler(table, levels.quanta, levels.boostPeriod);
+    }
+    
+    // In menu order
+    const AlgorithmKey ALGORITHM_KEYS[] = {
+        {"fcfs", false, false, [](const ProcessTable& t, const AlgorithmOptions&) -> Scheduler* { return new FCFSScheduler(t); }},
+        {"sjf", false, false, [](const ProcessTable& t, const AlgorithmOptions&) -> Scheduler* { return new SJFScheduler(t); }},
+        {"srtf", false, false, [](const ProcessTable& t, const AlgorithmOptions&) -> Scheduler* { return new SRTFScheduler(t); }},
+        {"rr", true, false, [](const ProcessTable& t, const AlgorithmOptions& o) -> Scheduler* { return new RRScheduler(t, o.timeQuantum); }},
+        {"priority", false, false, [](const ProcessTable& t, const AlgorithmOptions&) -> Scheduler* { return new PriorityScheduler(t); }},
+        {"priority-preemptive", false, false, [](const ProcessTable& t, const AlgorithmOptions&) -> Scheduler* { return new PreemptivePriorityScheduler(t); }},
+        {"ljf", false, false, [](const ProcessTable& t, const AlgorithmOptions&) -> Scheduler* { return new LJFScheduler(t); }},
+        {"lrtf", false, false, [](const ProcessTable& t, const AlgorithmOptions&) -> Scheduler* { return new LRTFScheduler(t); }},
+        {"hrrn", false, false, [](const ProcessTable& t, const AlgorithmOptions&) -> Scheduler* { return new HRRNScheduler(t); }},
+        {"mlfq", true, true, createMLFQ},
+    };
+    
+    SchedulerFactory factoryFor(const AlgorithmKey& algorithm, const AlgorithmOptions& options) {
+        Scheduler* (*create)(const ProcessTable&, const AlgorithmOptions&) = algorithm.create;
+        return [create, options](const ProcessTable& table) {
+            return unique_ptr<Scheduler>(create(table, options));
+        };
+    }
+    
+    int parseNumber(const string& text, int minimum) {
+        size_t used = 0;
+        int value = 0;
+        try {
+            value = stoi(text, &used);
+        } catch (const exception&) {
+            used = 0;
+        }
+        if (text.empty() || used != text.size() || value < minimum) {
+            throw invalid_argument(text);
+        }
+        return value;
+    }
+    
+    int parseQuantum(const string& text, const string& spec) {
+        try {
+            return parseNumber(text, 1);
+        } catch (const invalid_argument&) {
+            throw invalid_argument("Time quantum must be a positive number in '" + spec + "'");
+        }
+    }
+    
+    // Quanta are separated by '/', as ',' and ':' already separate specs and parameters
+    vector<int> parseQuanta(const string& text, const string& spec) {
+        vector<int> quanta;
+        stringstream stream(text);
+        string item;
+        while (getline(stream, item, '/')) {
+            quanta.push_back(parseQuantum(item, spec));
+        }
+        if (quanta.empty() || quanta.size() > static_cast<size_t>(PriorityRunQueue::LEVELS)) {
+            throw invalid_argument("MLFQ needs between 1 and " + to_string(PriorityRunQueue::LEVELS) +
+                                   " quanta in '" + spec + "'");
+        }
+        return quanta;
+    }
+}
+
+vector<SchedulerFactory> defaultAlgorithms(int timeQuantum) {
+    AlgorithmOptions options;
+    options.timeQuantum = timeQuantum;
+    
+    vector<SchedulerFactory> factories;
+    for (const auto& algorithm : ALGORITHM_KEYS) {
+        factories.push_back(factoryFor(algorithm, options));
+    }
+    return factories;
+}
+
+SchedulerFactory parseAlgorithm(const string& spec) {
+    stringstream stream(spec);
+    string key;
+    getline(stream, key, ':');
+    
+    const AlgorithmKey* algorithm = nullptr;
+    for (const auto& candidate : ALGORITHM_KEYS) {
+        if (key == candidate.key) {
+            algorithm = &candidate;
+        }
+    }
+    if (algorithm == nullptr) {
+        throw invalid_argument("Unknown algorithm '" + key + "'");
+    }
+    
+    AlgorithmOptions options;
+    string parameter;
+    while (getline(stream, parameter, ':')) {
+        size_t equals = parameter.find('=');
+        string name = parameter.substr(0, equals);
+        string value = equals == string::npos ? "" : parameter.substr(equals + 1);
+        if (algorithm->takesQuantum && (name == "q" || name == "quantum") && equals != string::npos) {
+            options.timeQuantum = parseQuantum(value, spec);
+        } else if (algorithm->takesLevels && name == "quanta" && equals != string::npos) {
+            options.quanta = parseQuanta(value, spec);
+        } else if (algorithm->takesLevels && name == "boost" && equals != string::npos) {
+            try {
+                options.boostPeriod = parseNumber(value, 0);
+            } catch (const invalid_argument&) {
+                throw invalid_argument("Boost period must be a number of at least 0 in '" + spec + "'");
+            }
+        } else {
+            throw invalid_argument("Invalid parameter '" + parameter + "' for " + key);
+        }
+    }
+    
+    // Report levels that overflow now rather than on the first run
+    if (algorithm->takesLevels) {
+        try {
+            resolveLevels(options);
+        } catch (const invalid_argument& e) {
+            throw invalid_argument(string(e.what()) + " in '" + spec + "'");
+        }
+    }
+    return factoryFor(*algorithm, options);
+}
+
+vector<SchedulerFactory> parseAlgorithms(const string& list) {
+    vector<SchedulerFactory> factories;
+    stringstream stream(list);
+    string spec;
+    while (getline(stream, spec, ',')) {
+        factories.push_back(parseAlgorithm(spec));
+    }
+    if (factories.empty()) {
+        throw invalid_argument("No algorithm given");
+    }
+    return factories;
+}
+
+ComparisonRunner::ComparisonRunner(size_t threads)
+    : cpus(1), queueMode(PER_CPU_QUEUES), pool(threads) {}
+
+void ComparisonRunner::add(SchedulerFactory factory) {
+    algorithms.push_back(move(factory));
+}
+
+void ComparisonRunner::addDefaultAlgorithms(int timeQuantum) {
+    for (auto& factory : defaultAlgorithms(timeQuantum)) {
+        add(move(factory));
+    }
+}
+
+void ComparisonRunner::setCpus(size_t count, QueueMode mode) {
+    if (count < 1) {
+        throw invalid_argument("A comparison needs at least one CPU");
+    }
+    cpus = count;
+    queueMode = mode;
+}
+
+size_t ComparisonRunner::size() const {
+    return algorithms.size();
+}
+
+vector<ComparisonEntry> ComparisonRunner::run(const ProcessTable& workload) {
+    vector<ComparisonEntry> entries(algorithms.size());
+    vector<exception_ptr> errors(algorithms.size());
+    
+    // Each task writes only its own slot, so no locking is needed and the
+    // output order does not depend on which worker finishes first
+    for (size_t i = 0; i < algorithms.size(); i++) {
+        pool.submit([this, i, &workload, &entries, &errors] {
+            try {
+                unique_ptr<Scheduler> scheduler = algorithms[i](workload);
+                scheduler->setCpus(cpus, queueMode);
+                entries[i].algorithmName = scheduler->getName();
+                entries[i].result = scheduler->run();
+            } catch (...) {
+                errors[i] = current_exception();
+            }
+        });
+    }
+    pool.wait();
+    
+    for (const auto& error : errors) {
+        if (error) {
+            rethrow_exception(error);
+        }
+    }
+    return entries;
+}
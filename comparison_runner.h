@@ -0,0 +1,117 @@
+#ifndef COMPARISON_RUNNER_H
+#define COMPARISON_RUNNER_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include "process_table.h"
+#include "scheduler.h"
+#include "thread_pool.h"
+
+using namespace std;
+
+/**
+ * @brief Builds a scheduler for a workload
+ * 
+ * Called on a worker thread, so it must only read the table.
+ */
+typedef function<unique_ptr<Scheduler>(const ProcessTable&)> SchedulerFactory;
+
+/**
+ * @brief Builds the ten algorithms of the interactive menu
+ * @param timeQuantum Time quantum for Round Robin, and the top-level quantum of MLFQ
+ * @return Factories in menu order
+ */
+vector<SchedulerFactory> defaultAlgorithms(int timeQuantum = 2);
+
+/**
+ * @brief Builds one algorithm from its key and parameters
+ * @param spec Key, optionally followed by ":name=value" parameters, such as "srtf" or "rr:q=4"
+ * @return Factory for the configured algorithm
+ * 
+ * Keys are fcfs, sjf, srtf, rr, priority, priority-preemptive, ljf, lrtf,
+ * hrrn and mlfq. Round Robin takes q, its time quantum (default 2). MLFQ
+ * takes q, its top-level quantum, which doubles for each of three levels;
+ * quanta, the quantum of every level separated by '/', such as
+ * "mlfq:quanta=2/4/8/16"; and boost, the boost period (default ten
+ * bottom-level quanta, 0 for none). The others take no parameters.
+ * Throws invalid_argument for anything else.
+ */
+SchedulerFactory parseAlgorithm(const string& spec);
+
+/**
+ * @brief Builds a comma-separated list of algorithms
+ * @param list Specs as accepted by parseAlgorithm(), such as "rr:q=4,srtf"
+ * @return Factories in the order given
+ */
+vector<SchedulerFactory> parseAlgorithms(const string& list);
+
+/**
+ * @struct ComparisonEntry
+ * @brief Result of one algorithm in a comparison
+ */
+struct ComparisonEntry {
+    string algorithmName;    // Scheduler::getName() of the algorithm
+    SchedulerResult result;  // Metrics and Gantt chart of its run
+};
+
+/**
+ * @class ComparisonRunner
+ * @brief Runs several scheduling algorithms on one workload concurrently
+ * 
+ * Every algorithm reads the same workload table, which is never modified,
+ * and gets its own scheduler built on a worker thread. Results come back in
+ * the order the algorithms were added, however the runs interleave.
+ */
+class ComparisonRunner {
+private:
+    vector<SchedulerFactory> algorithms;  // Algorithms to compare, in output order
+    size_t cpus;                          // Simulated CPUs in every run
+    QueueMode queueMode;                  // How those CPUs share ready processes
+    ThreadPool pool;                      // Workers shared by every run()
+
+public:
+    /**
+     * @brief Constructor for ComparisonRunner
+     * @param threads Number of worker threads, or 0 for one per hardware thread
+     */
+    explicit ComparisonRunner(size_t threads = 0);
+    
+    /**
+     * @brief Adds an algorithm to the comparison
+     * @param factory Builds the algorithm's scheduler for a workload
+     */
+    void add(SchedulerFactory factory);
+    
+    /**
+     * @brief Adds the ten algorithms of the interactive menu
+     * @param timeQuantum Time quantum for Round Robin, and the top-level quantum of MLFQ
+     */
+    void addDefaultAlgorithms(int timeQuantum = 2);
+    
+    /**
+     * @brief Sets the simulated CPUs every run uses
+     * @param count Number of CPUs, at least 1
+     * @param mode Whether the CPUs share one ready queue or each have their own
+     */
+    void setCpus(size_t count, QueueMode mode);
+    
+    /**
+     * @brief Gets the number of algorithms added so far
+     * @return Algorithm count
+     */
+    size_t size() const;
+    
+    /**
+     * @brief Runs every algorithm on a workload
+     * @param workload Workload shared read-only by all runs
+     * @return One entry per algorithm, in the order they were added
+     * 
+     * If a run throws, the first failing algorithm's exception is rethrown
+     * once all runs have finished.
+     */
+    vector<ComparisonEntry> run(const ProcessTable& workload);
+};
+
+#endif // COMPARISON_RUNNER_H
@@ -0,0 +1,42 @@
+#ifndef COMPLETION_SINK_H
+#define COMPLETION_SINK_H
+
+#include <string>
+
+using namespace std;
+
+/**
+ * @struct CompletedJob
+ * @brief Final record of a process handed out by a streaming run
+ */
+struct CompletedJob {
+    string id;            // Process ID
+    int arrivalTime;      // Time at which the process arrived
+    int burstTime;        // Total CPU time it used
+    int priority;         // Priority level
+    int completionTime;   // Time at which it completed
+    int responseTime;     // First dispatch time - arrival time
+};
+
+/**
+ * @class CompletionSink
+ * @brief Receives processes as they complete during a streaming run
+ * 
+ * The scheduler frees a process's state right after handing it over,
+ * so a sink that needs the data must copy it.
+ */
+class CompletionSink {
+public:
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~CompletionSink() = default;
+    
+    /**
+     * @brief Called once per process, in completion order
+     * @param job The process that just completed
+     */
+    virtual void onCompletion(const CompletedJob& job) = 0;
+};
+
+#endif // COMPLETION_SINK_H
@@ -0,0 +1,145 @@
+#include "csv_reader.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+    bool isBlank(char c) {
+        return c == ' ' || c == '\t';
+    }
+    
+    // Narrows [begin, end) to exclude surrounding spaces and tabs
+    void trim(const char*& begin, const char*& end) {
+        while (begin < end && isBlank(*begin)) {
+            begin++;
+        }
+        while (end > begin && isBlank(end[-1])) {
+            end--;
+        }
+    }
+    
+    // Parses a whole field as a signed decimal int without allocating
+    bool parseInt(const char* begin, const char* end, int& value) {
+        trim(begin, end);
+        
+        bool negative = false;
+        if (begin < end && (*begin == '-' || *begin == '+')) {
+            negative = *begin == '-';
+            begin++;
+        }
+        if (begin == end) {
+            return false;
+        }
+        
+        const long long limit = static_cast<long long>(numeric_limits<int>::max()) + (negative ? 1 : 0);
+        long long magnitude = 0;
+        for (; begin < end; begin++) {
+            if (*begin < '0' || *begin > '9') {
+                return false;
+            }
+            magnitude = magnitude * 10 + (*begin - '0');
+            if (magnitude > limit) {
+                return false;
+            }
+        }
+        
+        value = static_cast<int>(negative ? -magnitude : magnitude);
+        return true;
+    }
+    
+    runtime_error malformedLine(const string& filePath, size_t lineNumber, const string& message) {
+        return runtime_error(filePath + ":" + to_string(lineNumber) + ": " + message);
+    }
+}
+
+CsvProcessReader::CsvProcessReader(const string& filePath)
+    : filePath(filePath), file(filePath), cursor(file.data()), lineNumber(0) {}
+
+size_t CsvProcessReader::countLines() const {
+    return count(file.data(), file.data() + file.size(), '\n');
+}
+
+size_t CsvProcessReader::getLineNumber() const {
+    return lineNumber;
+}
+
+bool CsvProcessReader::next(Process& process) {
+    static const char* const columnNames[] = {"ID", "ArrivalTime", "BurstTime", "Priority", "Deadline"};
+    static const size_t MIN_FIELDS = 4;
+    static const size_t MAX_FIELDS = 5;
+    
+    const char* fileEnd = file.data() + file.size();
+    while (cursor < fileEnd) {
+        const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', fileEnd - cursor));
+        if (lineEnd == nullptr) {
+            lineEnd = fileEnd;
+        }
+        const char* lineBegin = cursor;
+        cursor = lineEnd < fileEnd ? lineEnd + 1 : fileEnd;
+        lineNumber++;
+        
+        if (lineEnd > lineBegin && lineEnd[-1] == '\r') {
+            lineEnd--;
+        }
+        
+        // Skip the header and blank lines
+        const char* contentBegin = lineBegin;
+        const char* contentEnd = lineEnd;
+        trim(contentBegin, contentEnd);
+        if (lineNumber == 1 || contentBegin == contentEnd) {
+            continue;
+        }
+        
+        // Split on commas in place
+        const char* fieldBegin[MAX_FIELDS];
+        const char* fieldEnd[MAX_FIELDS];
+        size_t fieldCount = 0;
+        const char* fieldStart = lineBegin;
+        while (true) {
+            const char* comma = static_cast<const char*>(memchr(fieldStart, ',', lineEnd - fieldStart));
+            const char* end = comma != nullptr ? comma : lineEnd;
+            if (fieldCount < MAX_FIELDS) {
+                fieldBegin[fieldCount] = fieldStart;
+                fieldEnd[fieldCount] = end;
+            }
+            fieldCount++;
+            if (comma == nullptr) {
+                break;
+            }
+            fieldStart = comma + 1;
+        }
+        
+        if (fieldCount < MIN_FIELDS || fieldCount > MAX_FIELDS) {
+            throw malformedLine(filePath, lineNumber, 
+                                "expected 4 or 5 fields, found " + to_string(fieldCount));
+        }
+        
+        trim(fieldBegin[0], fieldEnd[0]);
+        if (fieldBegin[0] == fieldEnd[0]) {
+            throw malformedLine(filePath, lineNumber, "empty ID");
+        }
+        
+        int values[MAX_FIELDS] = {0, 0, 0, 0, 0};
+        for (size_t field = 1; field < fieldCount; field++) {
+            if (!parseInt(fieldBegin[field], fieldEnd[field], values[field])) {
+                throw malformedLine(filePath, lineNumber, 
+                                    string("invalid integer in ") + columnNames[field] + " column");
+            }
+        }
+        
+        // Schedulers count remaining time down to zero
+        for (size_t field = 1; field <= 2; field++) {
+            if (values[field] < 0) {
+                throw malformedLine(filePath, lineNumber,
+                                    string("negative value in ") + columnNames[field] + " column");
+            }
+        }
+        
+        process = Process(string(fieldBegin[0], fieldEnd[0]), 
+                          values[1], values[2], values[3], values[4]);
+        return true;
+    }
+    
+    return false;
+}
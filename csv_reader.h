@@ -0,0 +1,55 @@
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include <string>
+#include <cstddef>
+#include "mapped_file.h"
+#include "process.h"
+
+using namespace std;
+
+/**
+ * @class CsvProcessReader
+ * @brief Incremental reader over a memory-mapped workload CSV
+ * 
+ * CSV format: ID,ArrivalTime,BurstTime,Priority[,Deadline]
+ * 
+ * Lines are scanned in place, one process per call to next(). The first
+ * line is a header and is skipped, as are blank lines. Throws runtime_error
+ * naming the file and line number of a malformed line.
+ */
+class CsvProcessReader {
+private:
+    string filePath;     // Path used in error messages
+    MappedFile file;     // Mapping of the whole file
+    const char* cursor;  // Start of the next unread line
+    size_t lineNumber;   // Number of the last line read
+
+public:
+    /**
+     * @brief Opens and maps a CSV file
+     * @param filePath Path to the CSV file
+     */
+    explicit CsvProcessReader(const string& filePath);
+    
+    /**
+     * @brief Reads the next process
+     * @param process Receives the process read
+     * @return False once the end of the file is reached
+     */
+    bool next(Process& process);
+    
+    /**
+     * @brief Counts newlines in the whole file, an upper bound on the number of processes
+     * @return Number of lines
+     */
+    size_t countLines() const;
+    
+    /**
+     * @brief Gets the number of the line last read
+     * @return 1-based line number
+     */
+    size_t getLineNumber() const;
+};
+
+#endif // CSV_READER_H
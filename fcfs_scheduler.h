@@ -2,6 +2,7 @@
 #define FCFS_SCHEDULER_H
 
 #include "scheduler.h"
+#include "ring_queue.h"
 
 /**
  * @class FCFSScheduler
@@ -12,6 +13,9 @@
  * it keeps it until it completes its CPU burst.
  */
 class FCFSScheduler : public Scheduler {
+private:
+    vector<RingQueue<uint32_t>> readyQueues; // Processes in arrival order, one slot per process each
+
 public:
     /**
      * @brief Constructor for FCFSScheduler
@@ -20,10 +24,10 @@ public:
     FCFSScheduler(const vector<Process>& processes);
     
     /**
-     * @brief Runs the FCFS scheduling algorithm
-     * @return SchedulerResult containing all metrics
+     * @brief Constructor for FCFSScheduler
+     * @param table Process table to schedule
      */
-    SchedulerResult run() override;
+    FCFSScheduler(const ProcessTable& table);
     
     /**
      * @brief Gets the name of the scheduling algorithm
@@ -36,6 +40,33 @@ public:
      * @return String description of the algorithm
      */
     string getDescription() const override;
+
+protected:
+    /**
+     * @brief Empties the ready queues and sizes them for PIDs below capacity
+     * @param capacity One past the largest PID that will be enqueued
+     */
+    void resetReadyQueue(size_t capacity) override;
+
+    /**
+     * @brief Sizes the ready queues for PIDs below capacity, keeping their contents
+     * @param capacity New upper bound on PIDs
+     */
+    void growReadyQueue(size_t capacity) override;
+
+    /**
+     * @brief Adds a newly arrived process to the ready queue
+     * @param pid Process that has just arrived
+     * @param queue Ready queue to add it to
+     */
+    void enqueue(uint32_t pid, size_t queue) override;
+
+    /**
+     * @brief Removes and returns the next process to dispatch from a ready queue
+     * @param queue Ready queue to take it from
+     * @return Next process, or NO_PID if the ready queue is empty
+     */
+    uint32_t dequeue(size_t queue) override;
 };
 
 #endif // FCFS_SCHEDULER_H
\ No newline at end of file
@@ -1,113 +1,42 @@
 #include "hrrn_scheduler.h"
-#include <algorithm>
-#include <limits>
 
 HRRNScheduler::HRRNScheduler(const vector<Process>& processes)
     : Scheduler(processes) {}
 
-double HRRNScheduler::calculateResponseRatio(const Process& process, int currentTime) const {
-    // Response Ratio = (Waiting Time + Burst Time) / Burst Time
-    // Waiting Time = Current Time - Arrival Time
-    int waitingTime = currentTime - process.getArrivalTime();
-    
-    // Ensure waiting time is not negative
-    waitingTime = waitingTime > 0 ? waitingTime : 0;
-    
-    // Calculate response ratio
-    return (waitingTime + process.getBurstTime()) / static_cast<double>(process.getBurstTime());
+HRRNScheduler::HRRNScheduler(const ProcessTable& table)
+    : Scheduler(table) {}
+
+void HRRNScheduler::resetReadyQueue(size_t capacity) {
+    readyQueues.resize(readyQueueCount());
+    for (auto& readyQueue : readyQueues) {
+        readyQueue.reset(capacity);
+    }
 }
 
-SchedulerResult HRRNScheduler::run() {
-    // Reset all processes and simulation time
-    resetProcesses();
-    
-    // Create a copy of processes to work with
-    vector<Process> processQueue = processes;
-    
-    // Sort processes by arrival time initially
-    sort(processQueue.begin(), processQueue.end(), 
-         [](const Process& a, const Process& b) {
-             return a.getArrivalTime() < b.getArrivalTime();
-         });
-    
-    // Track remaining processes
-    size_t completedProcesses = 0;
-    size_t totalProcesses = processQueue.size();
-    
-    // Main scheduling loop
-    while (completedProcesses < totalProcesses) {
-        // Find the process with highest response ratio among arrived processes
-        Process* selectedProcess = nullptr;
-        double highestRatio = -1.0;
-        
-        for (auto& process : processQueue) {
-            if (process.getArrivalTime() <= currentTime && 
-                process.getRemainingTime() > 0) {
-                
-                double ratio = calculateResponseRatio(process, currentTime);
-                
-                if (ratio > highestRatio) {
-                    selectedProcess = &process;
-                    highestRatio = ratio;
-                }
-            }
-        }
-        
-        // If we found a process to run
-        if (selectedProcess != nullptr) {
-            // Set response time if this is the first time process gets CPU
-            if (!selectedProcess->hasStarted()) {
-                selectedProcess->setResponseTime(currentTime - selectedProcess->getArrivalTime());
-            }
-            
-            // Since HRRN is non-preemptive, execute the process until completion
-            int burstTime = selectedProcess->getRemainingTime();
-            
-            // Add to Gantt chart for each time unit
-            for (int i = 0; i < burstTime; i++) {
-                ganttChart.push_back({selectedProcess->getId(), currentTime + i});
-            }
-            
-            // Execute the process for its full burst time
-            selectedProcess->execute(burstTime);
-            
-            // Update completion time
-            selectedProcess->setCompletionTime(currentTime + burstTime);
-            
-            // Update simulation time
-            currentTime += burstTime;
-            
-            // Increment completed processes counter
-            completedProcesses++;
-        } else {
-            // No process available at current time, advance time to next arrival
-            int nextArrival = numeric_limits<int>::max();
-            
-            for (const auto& process : processQueue) {
-                if (process.getArrivalTime() > currentTime && 
-                    process.getRemainingTime() > 0 && 
-                    process.getArrivalTime() < nextArrival) {
-                    nextArrival = process.getArrivalTime();
-                }
-            }
-            
-            // If there are no more arrivals, something went wrong
-            if (nextArrival == numeric_limits<int>::max()) {
-                break;
-            }
-            
-            // Add idle time to Gantt chart
-            for (int i = currentTime; i < nextArrival; i++) {
-                ganttChart.push_back({"IDLE", i});
-            }
-            
-            // Jump to next arrival time
-            currentTime = nextArrival;
-        }
+void HRRNScheduler::growReadyQueue(size_t capacity) {
+    for (auto& readyQueue : readyQueues) {
+        readyQueue.grow(capacity);
+    }
+}
+
+void HRRNScheduler::enqueue(uint32_t pid, size_t queue) {
+    ResponseRatioTree& readyQueue = readyQueues[queue];
+    readyQueue.advance(currentTime);
+    readyQueue.insert(pid, table->arrival[pid], table->burst[pid], table->sequence[pid]);
+}
+
+uint32_t HRRNScheduler::dequeue(size_t queue) {
+    // Bring the tournament up to now; only crossings since the last
+    // dispatch are replayed
+    ResponseRatioTree& readyQueue = readyQueues[queue];
+    readyQueue.advance(currentTime);
+    if (readyQueue.empty()) {
+        return NO_PID;
     }
     
-    // Calculate and return metrics
-    return calculateMetrics();
+    size_t selected = readyQueue.top();
+    readyQueue.erase(selected);
+    return static_cast<uint32_t>(selected);
 }
 
 string HRRNScheduler::getName() const {
@@ -2,6 +2,7 @@
 #define HRRN_SCHEDULER_H
 
 #include "scheduler.h"
+#include "response_ratio_tree.h"
 
 /**
  * @class HRRNScheduler
@@ -11,6 +12,9 @@
  * Response Ratio = (Waiting Time + Burst Time) / Burst Time
  */
 class HRRNScheduler : public Scheduler {
+private:
+    vector<ResponseRatioTree> readyQueues; // Arrived processes waiting for the CPU, by response ratio
+
 public:
     /**
      * @brief Constructor for HRRNScheduler
@@ -19,10 +23,10 @@ public:
     HRRNScheduler(const vector<Process>& processes);
     
     /**
-     * @brief Runs the HRRN scheduling algorithm
-     * @return SchedulerResult containing all metrics
+     * @brief Constructor for HRRNScheduler
+     * @param table Process table to schedule
      */
-    SchedulerResult run() override;
+    HRRNScheduler(const ProcessTable& table);
     
     /**
      * @brief Gets the name of the scheduling algorithm
@@ -35,15 +39,33 @@ public:
      * @return String description of the algorithm
      */
     string getDescription() const override;
-    
-private:
+
+protected:
+    /**
+     * @brief Empties the ready queues and sizes them for PIDs below capacity
+     * @param capacity One past the largest PID that will be enqueued
+     */
+    void resetReadyQueue(size_t capacity) override;
+
+    /**
+     * @brief Sizes the ready queues for PIDs below capacity, keeping their contents
+     * @param capacity New upper bound on PIDs
+     */
+    void growReadyQueue(size_t capacity) override;
+
+    /**
+     * @brief Adds a newly arrived process to the ready queue
+     * @param pid Process that has just arrived
+     * @param queue Ready queue to add it to
+     */
+    void enqueue(uint32_t pid, size_t queue) override;
+
     /**
-     * @brief Calculates the response ratio for a process
-     * @param process The process to calculate response ratio for
-     * @param currentTime The current simulation time
-     * @return The response ratio value
+     * @brief Removes and returns the next process to dispatch from a ready queue
+     * @param queue Ready queue to take it from
+     * @return Next process, or NO_PID if the ready queue is empty
      */
-    double calculateResponseRatio(const Process& process, int currentTime) const;
+    uint32_t dequeue(size_t queue) override;
 };
 
 #endif // HRRN_SCHEDULER_H
\ No newline at end of file
@@ -0,0 +1,185 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <vector>
+#include <cstddef>
+#include "scheduler_stats.h"
+#include "scratch_arena.h"
+
+using namespace std;
+
+/**
+ * @class IndexedHeap
+ * @brief Binary heap of dense integer IDs with a position index
+ *
+ * Holds IDs in the range [0, capacity) ordered by a comparator, so the
+ * best element is found in O(1) and inserted or removed in O(log n).
+ * The position index also lets any ID be erased or re-sifted in O(log n)
+ * after its key changes. Storage comes from the thread's ScratchArena.
+ *
+ * @tparam Compare Strict weak ordering on IDs; compare(a, b) is true when
+ *                 a should come out before b
+ */
+template <typename Compare>
+class IndexedHeap {
+private:
+    static const size_t npos = static_cast<size_t>(-1);
+
+    ScratchVector<size_t> heap;      // Heap-ordered IDs
+    ScratchVector<size_t> position;  // Slot of each ID in heap, or npos if absent
+    Compare compare;          // Ordering on IDs
+
+    void swapSlots(size_t i, size_t j) {
+        size_t a = heap[i];
+        size_t b = heap[j];
+        heap[i] = b;
+        heap[j] = a;
+        position[b] = i;
+        position[a] = j;
+    }
+
+    void siftUp(size_t slot) {
+        while (slot > 0) {
+            size_t parent = (slot - 1) / 2;
+            INSTRUMENT(scannedEntries++;)
+            if (!compare(heap[slot], heap[parent])) {
+                break;
+            }
+            swapSlots(slot, parent);
+            slot = parent;
+        }
+    }
+
+    void siftDown(size_t slot) {
+        size_t count = heap.size();
+        while (2 * slot + 1 < count) {
+            size_t left = 2 * slot + 1;
+            size_t right = left + 1;
+            INSTRUMENT(scannedEntries += 1 + (right < count);)
+            // One branch per child rather than a select of the better one:
+            // with the comparison inlined, a select becomes conditional moves
+            // that wait on every key load, while a branch lets the CPU run
+            // ahead into the next level of a heap too large for the cache
+            size_t child = left;
+            if (right < count && compare(heap[right], heap[left])) {
+                if (!compare(heap[right], heap[slot])) {
+                    break;
+                }
+                child = right;
+            } else if (!compare(heap[left], heap[slot])) {
+                break;
+            }
+            swapSlots(slot, child);
+            slot = child;
+        }
+    }
+
+    void removeSlot(size_t slot) {
+        size_t last = heap.size() - 1;
+        position[heap[slot]] = npos;
+        if (slot != last) {
+            heap[slot] = heap[last];
+            position[heap[slot]] = slot;
+        }
+        heap.pop_back();
+        if (slot < heap.size()) {
+            siftDown(slot);
+            siftUp(slot);
+        }
+    }
+
+public:
+    /**
+     * @brief Constructor for IndexedHeap
+     * @param compare Ordering on IDs
+     */
+    explicit IndexedHeap(const Compare& compare = Compare()) : compare(compare) {}
+
+    /**
+     * @brief Empties the heap and sizes the index for IDs below capacity
+     * @param capacity One past the largest ID that will be pushed
+     * 
+     * Takes fresh storage from the arena, so call it after the arena's reset.
+     */
+    void reset(size_t capacity) {
+        renew(heap);
+        heap.reserve(capacity);
+        renew(position);
+        position.assign(capacity, npos);
+    }
+
+    /**
+     * @brief Empties the heap, sizes it and replaces the ordering
+     * @param capacity One past the largest ID that will be pushed
+     * @param ordering New ordering on IDs
+     */
+    void reset(size_t capacity, const Compare& ordering) {
+        compare = ordering;
+        reset(capacity);
+    }
+
+    /**
+     * @brief Widens the index so IDs below capacity can be pushed, keeping contents
+     * @param capacity New upper bound on IDs; smaller values are ignored
+     */
+    void grow(size_t capacity) {
+        if (capacity > position.size()) {
+            position.resize(capacity, npos);
+        }
+    }
+
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    bool contains(size_t id) const { return id < position.size() && position[id] != npos; }
+
+    /**
+     * @brief Gets the best ID without removing it
+     * @return ID that compares before all others
+     */
+    size_t top() const { return heap.front(); }
+
+    /**
+     * @brief Inserts an ID that is not already in the heap
+     * @param id ID below the capacity given to reset()
+     */
+    void push(size_t id) {
+        position[id] = heap.size();
+        heap.push_back(id);
+        siftUp(heap.size() - 1);
+    }
+
+    /**
+     * @brief Removes and returns the best ID
+     * @return ID that compared before all others
+     */
+    size_t pop() {
+        size_t id = heap.front();
+        removeSlot(0);
+        return id;
+    }
+
+    /**
+     * @brief Removes an arbitrary ID if present
+     * @param id ID to remove
+     */
+    void erase(size_t id) {
+        if (contains(id)) {
+            removeSlot(position[id]);
+        }
+    }
+
+    /**
+     * @brief Restores heap order after the key of an ID has changed
+     * @param id ID whose key changed
+     */
+    void update(size_t id) {
+        size_t slot = position[id];
+        siftUp(slot);
+        siftDown(position[id]);
+    }
+};
+
+template <typename Compare>
+const size_t IndexedHeap<Compare>::npos;
+
+#endif // INDEXED_HEAP_H
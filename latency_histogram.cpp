@@ -0,0 +1,71 @@
+#include "latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+
+uint32_t LatencyHistogram::highestIn(size_t bucket) {
+    if (bucket < 2 * HALF_BUCKETS) {
+        return static_cast<uint32_t>(bucket);
+    }
+    size_t shift = bucket / HALF_BUCKETS - 1;
+    uint64_t lowest = static_cast<uint64_t>(bucket - shift * HALF_BUCKETS) << shift;
+    return static_cast<uint32_t>(lowest + (uint64_t(1) << shift) - 1);
+}
+
+LatencyHistogram::LatencyHistogram() : total(0), largest(0) {}
+
+void LatencyHistogram::grow(size_t bucket) {
+    counts.resize(bucket + 1, 0);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.counts.size() > counts.size()) {
+        counts.resize(other.counts.size(), 0);
+    }
+    for (size_t bucket = 0; bucket < other.counts.size(); bucket++) {
+        counts[bucket] += other.counts[bucket];
+    }
+    total += other.total;
+    largest = std::max(largest, other.largest);
+}
+
+void LatencyHistogram::clear() {
+    fill(counts.begin(), counts.end(), 0);
+    total = 0;
+    largest = 0;
+}
+
+uint64_t LatencyHistogram::count() const {
+    return total;
+}
+
+uint32_t LatencyHistogram::max() const {
+    return largest;
+}
+
+double LatencyHistogram::percentile(double percent) const {
+    if (total == 0) {
+        return 0;
+    }
+    // The smallest value with at least this many values at or below it
+    double exactRank = ceil(percent / 100.0 * total);
+    uint64_t rank = exactRank < 1 ? 1 : std::min(total, static_cast<uint64_t>(exactRank));
+    
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < counts.size(); bucket++) {
+        seen += counts[bucket];
+        if (seen >= rank) {
+            return std::min(highestIn(bucket), largest);
+        }
+    }
+    return largest;
+}
+
+TailLatency LatencyHistogram::tail() const {
+    TailLatency latency;
+    latency.p50 = percentile(50);
+    latency.p90 = percentile(90);
+    latency.p99 = percentile(99);
+    latency.p999 = percentile(99.9);
+    latency.max = largest;
+    return latency;
+}
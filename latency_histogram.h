@@ -0,0 +1,120 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * @struct TailLatency
+ * @brief Percentiles of one latency distribution
+ */
+struct TailLatency {
+    double p50;    // Median
+    double p90;    // 90th percentile
+    double p99;    // 99th percentile
+    double p999;   // 99.9th percentile
+    double max;    // Largest value recorded, exact
+};
+
+/**
+ * @class LatencyHistogram
+ * @brief Log-linear histogram of non-negative integer times, in the style of HDR histograms
+ * 
+ * Values below 256 get a counter each. Above that, every power-of-two range
+ * is split into 128 equal buckets, so a value is known to within 1/128 of
+ * itself. The whole 32-bit range needs at most 3328 counters, allocated
+ * only as far as the largest value recorded, so memory does not grow with
+ * the number of values. Merging adds counters, which is how the results of
+ * parallel runs are combined.
+ */
+class LatencyHistogram {
+private:
+    static const int EXACT_BITS = 8;                              // Values below 2^EXACT_BITS are exact
+    static const uint32_t HALF_BUCKETS = 1u << (EXACT_BITS - 1);  // Buckets per power of two above that
+    
+    vector<uint64_t> counts;     // Values recorded in each bucket
+    uint64_t total;              // Values recorded
+    uint32_t largest;            // Largest value recorded
+    
+    static size_t bucketOf(uint32_t value);
+    static uint32_t highestIn(size_t bucket);
+    void grow(size_t bucket);
+
+public:
+    /**
+     * @brief Constructor for an empty LatencyHistogram
+     */
+    LatencyHistogram();
+    
+    /**
+     * @brief Records one value
+     * @param value Time to record
+     */
+    void record(uint32_t value);
+    
+    /**
+     * @brief Adds every value of another histogram to this one
+     * @param other Histogram to merge in; left unchanged
+     */
+    void merge(const LatencyHistogram& other);
+    
+    /**
+     * @brief Removes every value, keeping the counters allocated
+     */
+    void clear();
+    
+    /**
+     * @brief Gets the number of values recorded
+     * @return Value count
+     */
+    uint64_t count() const;
+    
+    /**
+     * @brief Gets the largest value recorded
+     * @return Largest value, or 0 if empty
+     */
+    uint32_t max() const;
+    
+    /**
+     * @brief Gets a percentile
+     * @param percent Percentile between 0 and 100, such as 99.9
+     * @return Largest value in the bucket holding that rank, at most max(); 0 if empty
+     * 
+     * Reporting the top of the bucket means the result never understates
+     * the true percentile, and overstates it by less than 1/128.
+     */
+    double percentile(double percent) const;
+    
+    /**
+     * @brief Gets the percentiles usually checked against latency targets
+     * @return p50, p90, p99, p99.9 and max
+     */
+    TailLatency tail() const;
+};
+
+// Recorded once per metric for every completed process, so kept inline
+inline size_t LatencyHistogram::bucketOf(uint32_t value) {
+    if (value < 2 * HALF_BUCKETS) {
+        return value;
+    }
+    // Keep the top EXACT_BITS bits; the shift picks the power-of-two range
+    int shift = (31 - __builtin_clz(value)) - (EXACT_BITS - 1);
+    return static_cast<size_t>(shift) * HALF_BUCKETS + (value >> shift);
+}
+
+inline void LatencyHistogram::record(uint32_t value) {
+    size_t bucket = bucketOf(value);
+    if (bucket >= counts.size()) {
+        grow(bucket);
+    }
+    counts[bucket]++;
+    total++;
+    if (value > largest) {
+        largest = value;
+    }
+}
+
+#endif // LATENCY_HISTOGRAM_H
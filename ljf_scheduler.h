@@ -1,44 +1,43 @@
 #ifndef LJF_SCHEDULER_H
 #define LJF_SCHEDULER_H
 
-#include "scheduler.h"
+#include "policy_scheduler.h"
 
 /**
- * @class LJFScheduler
- * @brief Longest Job First scheduling algorithm implementation
- * 
- * Processes are executed based on their burst time, with the longest job getting priority.
- * This implementation supports both preemptive and non-preemptive modes.
+ * @struct LongestRemaining
+ * @brief Key policy for LJF and LRTF: longer remaining time first
  */
-class LJFScheduler : public Scheduler {
-private:
-    bool preemptive; // Flag to determine if scheduler is preemptive
-
-public:
-    /**
-     * @brief Constructor for LJFScheduler
-     * @param processes List of processes to schedule
-     * @param preemptive Flag to determine if scheduler is preemptive
-     */
-    LJFScheduler(const vector<Process>& processes, bool preemptive = false);
+struct LongestRemaining {
+    static const bool FIXED_KEY = false;         // Remaining times shrink as processes run
+    static const bool RUNNING_KEY_GROWS = true;  // The running process shrinks while waiting ones do not
     
-    /**
-     * @brief Runs the LJF scheduling algorithm
-     * @return SchedulerResult containing all metrics
-     */
-    SchedulerResult run() override;
+    static int key(uint32_t pid, const JobState& jobs, const ProcessTable& /*table*/) {
+        return -jobs.remaining[pid];
+    }
     
-    /**
-     * @brief Gets the name of the scheduling algorithm
-     * @return String name of the algorithm
-     */
-    string getName() const override;
-    
-    /**
-     * @brief Gets the description of the scheduling algorithm
-     * @return String description of the algorithm
-     */
-    string getDescription() const override;
+    static string name(bool preemptive);
+    static string description(bool preemptive);
 };
 
+/**
+ * @brief Ready-queue ordering of LJF and LRTF: longer remaining time first, then earlier arrival
+ */
+typedef KeyOrder<LongestRemaining> LongestRemainingFirst;
+
+/**
+ * @brief Longest Job First: the longest waiting job runs to completion
+ */
+typedef PolicyScheduler<LongestRemaining, NonPreemptive> LJFScheduler;
+
+/**
+ * @brief Longest Remaining Time First: the CPU goes to whichever process has the most work left
+ * 
+ * The running process loses the CPU as soon as it stops being the longest,
+ * so slices end exactly where a waiting process would overtake it.
+ */
+typedef PolicyScheduler<LongestRemaining, Preemptive> LRTFScheduler;
+
+extern template class PolicyScheduler<LongestRemaining, NonPreemptive>;
+extern template class PolicyScheduler<LongestRemaining, Preemptive>;
+
 #endif // LJF_SCHEDULER_H
\ No newline at end of file
@@ -2,38 +2,27 @@
 #include <vector>
 #include <iomanip>
 #include <string>
+#include <sstream>
+#include <fstream>
+#include <chrono>
+#include <algorithm>
+#include <utility>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
 
 #include "process.h"
 #include "process_loader.h"
-#include "fcfs_scheduler.h"
-#include "sjf_scheduler.h"
-#include "rr_scheduler.h"
-#include "priority_scheduler.h"
-#include "ljf_scheduler.h"
-#include "hrrn_scheduler.h"
+#include "comparison_runner.h"
+#include "parameter_sweep.h"
+#include "batch_runner.h"
+#include "replication_runner.h"
+#include "result_writer.h"
 
 using namespace std;
 
-// Function to print scheduler results
-void printResults(const string& algorithmName, const SchedulerResult& result) {
-    cout << "\n===== " << algorithmName << " =====" << endl;
-    cout << "Average Turnaround Time: " << fixed << setprecision(2) << result.avgTurnaroundTime << endl;
-    cout << "Average Waiting Time: " << fixed << setprecision(2) << result.avgWaitingTime << endl;
-    cout << "Average Response Time: " << fixed << setprecision(2) << result.avgResponseTime << endl;
-    cout << "CPU Utilization: " << fixed << setprecision(2) << result.cpuUtilization << "%" << endl;
-    
-    cout << "\nGantt Chart:" << endl;
-    cout << "|";
-    for (const auto& entry : result.ganttChart) {
-        cout << " " << entry.first << " |";
-    }
-    cout << "\n|";
-    for (const auto& entry : result.ganttChart) {
-        cout << " " << entry.second << " |";
-    }
-    cout << "\n" << endl;
-}
-
 // Function to display the menu and get user choice
 int displayMenu() {
     int choice;
@@ -51,7 +40,576 @@ int displayMenu() {
     return choice;
 }
 
-int main() {
+// Splits a comma-separated list
+vector<string> splitList(const string& text) {
+    vector<string> items;
+    stringstream stream(text);
+    string item;
+    while (getline(stream, item, ',')) {
+        items.push_back(item);
+    }
+    return items;
+}
+
+// Parses a count option that must be at least 1 and fit in an int
+size_t parseCount(const string& option, const string& value) {
+    long long count = 0;
+    for (char c : value) {
+        if (c < '0' || c > '9' || count > numeric_limits<int>::max()) {
+            count = 0;
+            break;
+        }
+        count = count * 10 + (c - '0');
+    }
+    if (count < 1 || count > numeric_limits<int>::max()) {
+        throw invalid_argument(option + " takes a positive number up to " +
+                               to_string(numeric_limits<int>::max()));
+    }
+    return static_cast<size_t>(count);
+}
+
+// Parses --format for the modes that write their own tables, which have no binary form
+ResultFormat parseTableFormat(const string& mode, const string& value) {
+    ResultFormat format = ResultWriter::parseFormat(value);
+    if (format == BINARY_RESULTS) {
+        throw invalid_argument(mode + " writes text, csv or json");
+    }
+    return format;
+}
+
+// Parses a whole option value as a finite number
+double parseNumber(const string& option, const string& value) {
+    const char* begin = value.c_str();
+    char* end = nullptr;
+    errno = 0;
+    double number = strtod(begin, &end);
+    if (value.empty() || isspace(static_cast<unsigned char>(value[0])) || *end != '\0' ||
+        errno == ERANGE || !isfinite(number)) {
+        throw invalid_argument("Invalid value '" + value + "' for " + option);
+    }
+    return number;
+}
+
+// Parses the value of --queue
+QueueMode parseQueueMode(const string& value) {
+    if (value == "global") {
+        return GLOBAL_QUEUE;
+    }
+    if (value == "per-cpu") {
+        return PER_CPU_QUEUES;
+    }
+    throw invalid_argument("--queue takes global or per-cpu");
+}
+
+// Runs a parameter sweep from the command line:
+//   cpu_scheduler --sweep <workload> [--algorithms rr,sjf,...] [--quantum 1:16[:step]]
+//                 [--preemptive on|off|both] [--cpus N] [--queue global|per-cpu]
+//                 [--threads N] [--format text|csv|json]
+// Returns 0 on success, 1 on a failed run and 2 on a usage error.
+int runSweep(int argc, char* argv[]) {
+    string usage = string("Usage: ") + argv[0] + " --sweep <workload> [--algorithms rr,sjf,...] "
+                   "[--quantum 1:16[:step]] [--preemptive on|off|both] [--cpus N] "
+                   "[--queue global|per-cpu] [--threads N] [--format text|csv|json]\n";
+    if (argc < 3) {
+        cerr << usage;
+        return 2;
+    }
+    
+    string workloadPath = argv[2];
+    size_t threads = 0;
+    size_t cpus = 1;
+    QueueMode queueMode = PER_CPU_QUEUES;
+    ResultFormat format = TEXT_RESULTS;
+    vector<string> algorithms;
+    vector<int> quanta;
+    vector<bool> preemptive;
+    
+    try {
+        for (int i = 3; i < argc; i++) {
+            string option = argv[i];
+            if (i + 1 >= argc) {
+                throw invalid_argument("Missing value for " + option);
+            }
+            string value = argv[++i];
+            
+            if (option == "--algorithms") {
+                algorithms = splitList(value);
+            } else if (option == "--format") {
+                format = parseTableFormat("--sweep", value);
+            } else if (option == "--quantum") {
+                quanta = ParameterSweep::parseRange(value);
+            } else if (option == "--preemptive") {
+                if (value == "on") {
+                    preemptive = {true};
+                } else if (value == "off") {
+                    preemptive = {false};
+                } else if (value == "both") {
+                    preemptive = {false, true};
+                } else {
+                    throw invalid_argument("--preemptive takes on, off or both");
+                }
+            } else if (option == "--cpus") {
+                cpus = parseCount(option, value);
+            } else if (option == "--queue") {
+                queueMode = parseQueueMode(value);
+            } else if (option == "--threads") {
+                threads = parseCount(option, value);
+            } else {
+                throw invalid_argument("Unknown option " + option);
+            }
+        }
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n" << usage;
+        return 2;
+    }
+    
+    try {
+        ParameterSweep sweep(threads);
+        if (!algorithms.empty()) {
+            sweep.setAlgorithms(algorithms);
+        }
+        if (!quanta.empty()) {
+            sweep.setQuanta(quanta);
+        }
+        if (!preemptive.empty()) {
+            sweep.setPreemptive(preemptive);
+        }
+        sweep.setCpus(cpus, queueMode);
+        
+        ProcessTable workload = ProcessLoader::loadTable(workloadPath);
+        vector<SweepRow> rows = sweep.run(workload);
+        if (format == CSV_RESULTS) {
+            ParameterSweep::writeCsv(cout, rows);
+        } else if (format == JSON_RESULTS) {
+            ParameterSweep::writeJson(cout, rows);
+        } else {
+            ParameterSweep::writeTable(cout, rows);
+        }
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    
+    return 0;
+}
+
+// Simulates every workload file matching the given directories or patterns:
+//   cpu_scheduler --batch <directory|pattern>... [--output results.csv]
+//                 [--format text|csv|json|binary] [--quantum N] [--cpus N]
+//                 [--queue global|per-cpu] [--threads N] [--in-flight N]
+// Writes the summary of every file and algorithm, in file order, to one
+// file. Returns 0 if every file ran, 1 if any failed and 2 on a usage error.
+int runBatch(int argc, char* argv[]) {
+    string usage = string("Usage: ") + argv[0] + " --batch <directory|pattern>... [--output results.csv] "
+                   "[--format text|csv|json|binary] [--quantum N] [--cpus N] [--queue global|per-cpu] "
+                   "[--threads N] [--in-flight N]\n";
+    
+    vector<string> patterns;
+    string outputPath = "batch_results.csv";
+    ResultFormat format = CSV_RESULTS;
+    int timeQuantum = 2;
+    size_t cpus = 1;
+    QueueMode queueMode = PER_CPU_QUEUES;
+    size_t threads = 0;
+    size_t inFlight = 0;
+    
+    try {
+        for (int i = 2; i < argc; i++) {
+            string option = argv[i];
+            if (option.compare(0, 2, "--") != 0) {
+                patterns.push_back(option);
+                continue;
+            }
+            if (i + 1 >= argc) {
+                throw invalid_argument("Missing value for " + option);
+            }
+            string value = argv[++i];
+            
+            if (option == "--output") {
+                outputPath = value;
+            } else if (option == "--format") {
+                format = ResultWriter::parseFormat(value);
+            } else if (option == "--quantum") {
+                timeQuantum = static_cast<int>(parseCount(option, value));
+            } else if (option == "--cpus") {
+                cpus = parseCount(option, value);
+            } else if (option == "--queue") {
+                queueMode = parseQueueMode(value);
+            } else if (option == "--threads") {
+                threads = parseCount(option, value);
+            } else if (option == "--in-flight") {
+                inFlight = parseCount(option, value);
+            } else {
+                throw invalid_argument("Unknown option " + option);
+            }
+        }
+        if (patterns.empty()) {
+            throw invalid_argument("No workload directory or pattern given");
+        }
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n" << usage;
+        return 2;
+    }
+    
+    try {
+        vector<string> files;
+        for (const auto& pattern : patterns) {
+            vector<string> matches = BatchRunner::findWorkloads(pattern);
+            files.insert(files.end(), matches.begin(), matches.end());
+        }
+        
+        ofstream output(outputPath, format == BINARY_RESULTS ? ios::out | ios::binary : ios::out);
+        if (!output) {
+            throw runtime_error("Failed to open file: " + outputPath);
+        }
+        
+        BatchRunner batch(threads, inFlight);
+        batch.addDefaultAlgorithms(timeQuantum);
+        batch.setCpus(cpus, queueMode);
+        
+        // The batch keeps only the metrics of each run
+        unique_ptr<ResultWriter> writer = ResultWriter::create(format, output, SUMMARY_SECTION);
+        auto start = chrono::steady_clock::now();
+        size_t failures = batch.run(files, [&writer](const BatchFileResult& result) {
+            if (!result.error.empty()) {
+                cerr << "Error: " << result.path << ": " << result.error << "\n";
+                writer->writeFailure(result.path, result.error);
+                return;
+            }
+            for (const auto& entry : result.entries) {
+                writer->write(result.path, result.workload, entry);
+            }
+        });
+        writer->finish();
+        output.close();
+        if (!output) {
+            throw runtime_error("Failed to write file: " + outputPath);
+        }
+        
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "Simulated " << files.size() - failures << " of " << files.size() << " files into "
+             << outputPath << " in " << seconds << " s\n";
+        return failures == 0 ? 0 : 1;
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+// Estimates every algorithm's metrics over independent generated workloads:
+//   cpu_scheduler --replicate [--algorithms rr:q=4,srtf,...] [--replications N]
+//                 [--min-replications N] [--precision F] [--quantum N] [--cpus N]
+//                 [--queue global|per-cpu] [--threads N] [--format text|csv|json]
+//                 [workload_generate options]
+// Returns 0 on success, 1 on a failed run and 2 on a usage error.
+int runReplicate(int argc, char* argv[]) {
+    string usage = string("Usage: ") + argv[0] + " --replicate [--algorithms rr:q=4,srtf,...] "
+                   "[--replications N] [--min-replications N] [--precision F] [--quantum N] [--cpus N] "
+                   "[--queue global|per-cpu] [--threads N] [--format text|csv|json] [workload options]\n"
+                   "Workload options:\n";
+    
+    WorkloadSpec spec;
+    vector<SchedulerFactory> algorithms;
+    bool quantumGiven = false;
+    size_t replications = 0;
+    size_t minReplications = 0;
+    double precision = 0;
+    int timeQuantum = 2;
+    size_t cpus = 1;
+    QueueMode queueMode = PER_CPU_QUEUES;
+    size_t threads = 0;
+    ResultFormat format = TEXT_RESULTS;
+    
+    try {
+        for (int i = 2; i < argc; i++) {
+            string option = argv[i];
+            if (i + 1 >= argc) {
+                throw invalid_argument("Missing value for " + option);
+            }
+            string value = argv[++i];
+            
+            if (option == "--algorithms") {
+                algorithms = parseAlgorithms(value);
+            } else if (option == "--format") {
+                format = parseTableFormat("--replicate", value);
+            } else if (option == "--replications") {
+                replications = parseCount(option, value);
+            } else if (option == "--min-replications") {
+                minReplications = parseCount(option, value);
+            } else if (option == "--precision") {
+                precision = parseNumber(option, value);
+                if (!(precision > 0)) {
+                    throw invalid_argument("--precision takes a positive fraction");
+                }
+            } else if (option == "--quantum") {
+                timeQuantum = static_cast<int>(parseCount(option, value));
+                quantumGiven = true;
+            } else if (option == "--cpus") {
+                cpus = parseCount(option, value);
+            } else if (option == "--queue") {
+                queueMode = parseQueueMode(value);
+            } else if (option == "--threads") {
+                threads = parseCount(option, value);
+            } else if (!spec.parseOption(option, value)) {
+                throw invalid_argument("Unknown option " + option);
+            }
+        }
+        
+        // Without a target every replication runs; with one, the cap is
+        // generous and stopping is left to the target
+        if (replications == 0) {
+            replications = precision > 0 ? 1000 : 30;
+        }
+        if (minReplications == 0) {
+            minReplications = precision > 0 ? min<size_t>(10, replications) : replications;
+        }
+        if (minReplications < 2 || minReplications > replications) {
+            throw invalid_argument("Replications must satisfy 2 <= --min-replications <= --replications");
+        }
+        if (quantumGiven && !algorithms.empty()) {
+            throw invalid_argument("--quantum applies to the default algorithms; give rr:q=N in --algorithms");
+        }
+        spec.validate();
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n" << usage;
+        WorkloadSpec::printOptions(cerr);
+        return 2;
+    }
+    
+    try {
+        ReplicationRunner runner(spec, threads);
+        if (algorithms.empty()) {
+            runner.addDefaultAlgorithms(timeQuantum);
+        }
+        for (auto& factory : algorithms) {
+            runner.add(move(factory));
+        }
+        runner.setCpus(cpus, queueMode);
+        runner.setReplications(minReplications, replications);
+        runner.setPrecision(precision);
+        
+        vector<ReplicationEstimate> estimates = runner.run();
+        if (format == CSV_RESULTS) {
+            ReplicationRunner::writeCsv(cout, estimates);
+        } else if (format == JSON_RESULTS) {
+            ReplicationRunner::writeJson(cout, estimates);
+        } else {
+            ReplicationRunner::writeTable(cout, estimates);
+        }
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    
+    return 0;
+}
+
+// Runs the ten menu algorithms on a workload and prints their instrumentation as JSON:
+//   cpu_scheduler --stats <workload> [--quantum N] [--cpus N] [--queue global|per-cpu]
+// Counts and timings are only collected in builds made with make STATS=1.
+// Returns 0 on success, 1 on a failed run and 2 on a usage error.
+int runStats(int argc, char* argv[]) {
+    string usage = string("Usage: ") + argv[0] + " --stats <workload> [--quantum N] [--cpus N] "
+                   "[--queue global|per-cpu]\n";
+    if (argc < 3) {
+        cerr << usage;
+        return 2;
+    }
+    
+    string workloadPath = argv[2];
+    int timeQuantum = 2;
+    size_t cpus = 1;
+    QueueMode queueMode = PER_CPU_QUEUES;
+    
+    try {
+        for (int i = 3; i < argc; i++) {
+            string option = argv[i];
+            if (i + 1 >= argc) {
+                throw invalid_argument("Missing value for " + option);
+            }
+            string value = argv[++i];
+            
+            if (option == "--quantum") {
+                timeQuantum = static_cast<int>(parseCount(option, value));
+            } else if (option == "--cpus") {
+                cpus = parseCount(option, value);
+            } else if (option == "--queue") {
+                queueMode = parseQueueMode(value);
+            } else {
+                throw invalid_argument("Unknown option " + option);
+            }
+        }
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n" << usage;
+        return 2;
+    }
+    
+    if (!SchedulerStats().enabled) {
+        cerr << "Warning: built without instrumentation; rebuild with make STATS=1 to collect stats\n";
+    }
+    
+    try {
+        ProcessTable workload = ProcessLoader::loadTable(workloadPath);
+        
+        // One algorithm at a time, so the timings are not skewed by the others
+        cout << "[\n";
+        vector<SchedulerFactory> algorithms = defaultAlgorithms(timeQuantum);
+        for (size_t i = 0; i < algorithms.size(); i++) {
+            unique_ptr<Scheduler> scheduler = algorithms[i](workload);
+            scheduler->setCpus(cpus, queueMode);
+            SchedulerResult result = scheduler->run();
+            cout << "  ";
+            result.stats.writeJson(cout, scheduler->getName());
+            cout << (i + 1 < algorithms.size() ? ",\n" : "\n");
+        }
+        cout << "]\n";
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    
+    return 0;
+}
+
+// Runs chosen algorithms on workload files without the menu, for scripts:
+//   cpu_scheduler <workload>... [--algorithms rr:q=4,srtf,...] [--format text|csv|json|binary]
+//                 [--sections summary,processes,gantt] [--output results.txt] [--cpus N]
+//                 [--queue global|per-cpu] [--threads N]
+// Only the listed algorithms are built. Returns 0 if every workload ran, 1 if
+// any failed and 2 on a usage error.
+int runWorkloads(int argc, char* argv[]) {
+    string usage = string("Usage: ") + argv[0] + " <workload>... [--algorithms rr:q=4,srtf,...] "
+                   "[--format text|csv|json|binary] [--sections summary,processes,gantt] [--output PATH] "
+                   "[--cpus N] [--queue global|per-cpu] [--threads N]\n"
+                   "       " + argv[0] + " --sweep|--batch|--replicate|--stats ...\n"
+                   "Algorithms: fcfs, sjf, srtf, rr[:q=N], priority, priority-preemptive, ljf, lrtf, hrrn,\n"
+                   "            mlfq[:q=N][:quanta=N/N/...][:boost=N]\n"
+                   "Without arguments the interactive menu starts.\n";
+    
+    vector<string> workloadPaths;
+    vector<SchedulerFactory> algorithms;
+    ResultFormat format = TEXT_RESULTS;
+    unsigned sections = 0;
+    string outputPath;
+    size_t cpus = 1;
+    QueueMode queueMode = PER_CPU_QUEUES;
+    size_t threads = 0;
+    
+    ofstream file;
+    unique_ptr<ResultWriter> writer;
+    try {
+        for (int i = 1; i < argc; i++) {
+            string option = argv[i];
+            if (option == "--help" || option == "-h") {
+                cout << usage;
+                return 0;
+            }
+            if (option.size() < 2 || option[0] != '-') {
+                workloadPaths.push_back(option);
+                continue;
+            }
+            if (i + 1 >= argc) {
+                throw invalid_argument("Missing value for " + option);
+            }
+            string value = argv[++i];
+            
+            if (option == "--algorithms") {
+                algorithms = parseAlgorithms(value);
+            } else if (option == "--format") {
+                format = ResultWriter::parseFormat(value);
+            } else if (option == "--sections") {
+                sections = ResultWriter::parseSections(value);
+            } else if (option == "--output") {
+                outputPath = value;
+            } else if (option == "--cpus") {
+                cpus = parseCount(option, value);
+            } else if (option == "--queue") {
+                queueMode = parseQueueMode(value);
+            } else if (option == "--threads") {
+                threads = parseCount(option, value);
+            } else {
+                throw invalid_argument("Unknown option " + option);
+            }
+        }
+        if (workloadPaths.empty()) {
+            throw invalid_argument("No workload file given");
+        }
+        
+        // The text report shows the menu's metrics and chart; the other
+        // formats default to the metrics alone
+        if (sections == 0) {
+            sections = format == TEXT_RESULTS ? SUMMARY_SECTION | GANTT_SECTION : SUMMARY_SECTION;
+        }
+        if (!outputPath.empty()) {
+            file.open(outputPath, format == BINARY_RESULTS ? ios::out | ios::binary : ios::out);
+            if (!file) {
+                cerr << "Error: Failed to open file: " << outputPath << "\n";
+                return 1;
+            }
+        }
+        writer = ResultWriter::create(format, outputPath.empty() ? cout : file, sections);
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n" << usage;
+        return 2;
+    }
+    
+    try {
+        ComparisonRunner runner(threads);
+        if (algorithms.empty()) {
+            runner.addDefaultAlgorithms(2);
+        }
+        for (auto& factory : algorithms) {
+            runner.add(move(factory));
+        }
+        runner.setCpus(cpus, queueMode);
+        
+        size_t failures = 0;
+        for (const auto& path : workloadPaths) {
+            try {
+                ProcessTable workload = ProcessLoader::loadTable(path);
+                if (workload.size() == 0) {
+                    throw runtime_error("No processes in file");
+                }
+                for (const auto& entry : runner.run(workload)) {
+                    writer->write(path, workload, entry);
+                }
+            } catch (const exception& e) {
+                failures++;
+                cerr << "Error: " << path << ": " << e.what() << "\n";
+                writer->writeFailure(path, e.what());
+            }
+        }
+        
+        writer->finish();
+        return failures == 0 ? 0 : 1;
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--sweep") {
+        return runSweep(argc, argv);
+    }
+    if (argc > 1 && string(argv[1]) == "--batch") {
+        return runBatch(argc, argv);
+    }
+    if (argc > 1 && string(argv[1]) == "--replicate") {
+        return runReplicate(argc, argv);
+    }
+    if (argc > 1 && string(argv[1]) == "--stats") {
+        return runStats(argc, argv);
+    }
+    if (argc > 1) {
+        return runWorkloads(argc, argv);
+    }
+    
+    // FCFS, SJF, SRTF, RR (quantum 2), both Priority, both LJF, HRRN and MLFQ (quanta 2, 4 and 8)
+    ComparisonRunner runner;
+    runner.addDefaultAlgorithms(2);
+    unique_ptr<ResultWriter> report = ResultWriter::create(TEXT_RESULTS, cout, SUMMARY_SECTION | GANTT_SECTION);
+    
     while (true) {
         int choice = displayMenu();
         if (choice == 0) {
@@ -68,10 +626,10 @@ int main() {
         string selectedFile = testCases[choice - 1];
         cout << "\nLoading processes from: " << selectedFile << "\n";
         
-        // Load processes from the selected file
-        vector<Process> processes;
+        // Load processes from the selected file (CSV or binary workload)
+        ProcessTable processes;
         try {
-            processes = ProcessLoader::loadFromCSV(selectedFile);
+            processes = ProcessLoader::loadTable(selectedFile);
             cout << "Loaded " << processes.size() << " processes.\n";
         } catch (const exception& e) {
             cout << "Error: " << e.what() << "\n";
@@ -82,54 +640,21 @@ int main() {
             cout << "No processes loaded. Please select another file.\n";
             continue;
         }
-    
-    // Run different scheduling algorithms
-    
-    // 1. First Come First Serve (FCFS)
-    FCFSScheduler fcfs(processes);
-    SchedulerResult fcfsResult = fcfs.run();
-    printResults(fcfs.getName(), fcfsResult);
-    
-    // 2. Shortest Job First (SJF) - Non-preemptive
-    SJFScheduler sjf(processes, false);
-    SchedulerResult sjfResult = sjf.run();
-    printResults(sjf.getName(), sjfResult);
-    
-    // 3. Shortest Job First (SJF) - Preemptive (SRTF)
-    SJFScheduler srtf(processes, true);
-    SchedulerResult srtfResult = srtf.run();
-    printResults(srtf.getName(), srtfResult);
-    
-    // 4. Round Robin (RR) with time quantum = 2
-    RRScheduler rr(processes, 2);
-    SchedulerResult rrResult = rr.run();
-    printResults(rr.getName(), rrResult);
-    
-    // 5. Priority Scheduling - Non-preemptive
-    PriorityScheduler ps(processes, false);
-    SchedulerResult psResult = ps.run();
-    printResults(ps.getName(), psResult);
-    
-    // 6. Priority Scheduling - Preemptive
-    PriorityScheduler pps(processes, true);
-    SchedulerResult ppsResult = pps.run();
-    printResults(pps.getName(), ppsResult);
-    
-    // 7. Longest Job First (LJF) - Non-preemptive
-    LJFScheduler ljf(processes, false);
-    SchedulerResult ljfResult = ljf.run();
-    printResults(ljf.getName(), ljfResult);
-    
-    // 8. Longest Job First (LJF) - Preemptive (LRTF)
-    LJFScheduler lrtf(processes, true);
-    SchedulerResult lrtfResult = lrtf.run();
-    printResults(lrtf.getName(), lrtfResult);
-    
-    // 9. Highest Response Ratio Next (HRRN)
-    HRRNScheduler hrrn(processes);
-    SchedulerResult hrrnResult = hrrn.run();
-    printResults(hrrn.getName(), hrrnResult);
-    
+        
+        // Run every algorithm concurrently on the shared workload; results
+        // come back in menu order
+        vector<ComparisonEntry> entries;
+        try {
+            entries = runner.run(processes);
+        } catch (const exception& e) {
+            cout << "Error: " << e.what() << "\n";
+            continue;
+        }
+        
+        for (const auto& entry : entries) {
+            report->write("", processes, entry);
+        }
+        report->flush();
     }
     return 0;
 }
\ No newline at end of file
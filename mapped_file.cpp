@@ -0,0 +1,100 @@
+#include "mapped_file.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const string& filePath)
+    : bytes(nullptr), length(0), fileHandle(INVALID_HANDLE_VALUE), mapHandle(nullptr) {
+    fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                             OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        throw runtime_error("Failed to open file: " + filePath);
+    }
+    
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize)) {
+        release();
+        throw runtime_error("Failed to get size of file: " + filePath);
+    }
+    length = static_cast<size_t>(fileSize.QuadPart);
+    if (length == 0) {
+        return;
+    }
+    
+    mapHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapHandle != nullptr) {
+        bytes = static_cast<const char*>(MapViewOfFile(mapHandle, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (bytes == nullptr) {
+        release();
+        throw runtime_error("Failed to map file: " + filePath);
+    }
+}
+
+void MappedFile::release() {
+    if (bytes != nullptr) {
+        UnmapViewOfFile(bytes);
+        bytes = nullptr;
+    }
+    if (mapHandle != nullptr) {
+        CloseHandle(mapHandle);
+        mapHandle = nullptr;
+    }
+    if (fileHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(fileHandle);
+        fileHandle = INVALID_HANDLE_VALUE;
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const string& filePath) : bytes(nullptr), length(0) {
+    int fd = open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw runtime_error("Failed to open file: " + filePath);
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw runtime_error("Failed to get size of file: " + filePath);
+    }
+    length = static_cast<size_t>(info.st_size);
+    if (length == 0) {
+        close(fd);
+        return;
+    }
+    
+    void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps its own reference to the file
+    if (mapping == MAP_FAILED) {
+        length = 0;
+        throw runtime_error("Failed to map file: " + filePath);
+    }
+    
+    // The whole file is read front to back
+    madvise(mapping, length, MADV_SEQUENTIAL);
+    bytes = static_cast<const char*>(mapping);
+}
+
+void MappedFile::release() {
+    if (bytes != nullptr) {
+        munmap(const_cast<char*>(bytes), length);
+        bytes = nullptr;
+    }
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    release();
+}
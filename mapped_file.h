@@ -0,0 +1,47 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file
+ * 
+ * The mapping is released when the object is destroyed. An empty file maps
+ * to a null pointer with size 0. Throws runtime_error if the file cannot be
+ * opened or mapped.
+ */
+class MappedFile {
+private:
+    const char* bytes;  // Start of the mapping
+    size_t length;      // Size of the file in bytes
+#ifdef _WIN32
+    void* fileHandle;   // Handle of the open file
+    void* mapHandle;    // Handle of the file mapping object
+#endif
+
+    void release();
+
+public:
+    /**
+     * @brief Maps a file into memory
+     * @param filePath Path to the file
+     */
+    explicit MappedFile(const string& filePath);
+    
+    /**
+     * @brief Unmaps the file
+     */
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,222 @@
+#include "mlfq_scheduler.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+const int MLFQScheduler::DEFAULT_LEVELS;
+const int MLFQScheduler::DEFAULT_BOOST_QUANTA;
+
+MLFQScheduler::MLFQScheduler(const vector<Process>& processes, int timeQuantum)
+    : Scheduler(processes), boostPeriod(0), epoch(0), nextBoost(0) {
+    setTimeQuantum(timeQuantum);
+}
+
+MLFQScheduler::MLFQScheduler(const ProcessTable& table, int timeQuantum)
+    : Scheduler(table), boostPeriod(0), epoch(0), nextBoost(0) {
+    setTimeQuantum(timeQuantum);
+}
+
+MLFQScheduler::MLFQScheduler(const ProcessTable& table, const vector<int>& quanta, int boostPeriod)
+    : Scheduler(table), boostPeriod(0), epoch(0), nextBoost(0) {
+    setLevels(quanta, boostPeriod);
+}
+
+void MLFQScheduler::setLevels(const vector<int>& quanta, int boostPeriod) {
+    if (quanta.empty() || quanta.size() > static_cast<size_t>(PriorityRunQueue::LEVELS)) {
+        throw invalid_argument("MLFQ needs between 1 and " + to_string(PriorityRunQueue::LEVELS) + " levels");
+    }
+    for (int quantum : quanta) {
+        if (quantum < 1) {
+            throw invalid_argument("Time quantum must be at least 1");
+        }
+    }
+    if (boostPeriod < 0) {
+        throw invalid_argument("Boost period must not be negative");
+    }
+    this->quanta = quanta;
+    this->boostPeriod = boostPeriod;
+}
+
+vector<int> MLFQScheduler::doublingQuanta(int timeQuantum) {
+    vector<int> quanta;
+    for (int i = 0; i < DEFAULT_LEVELS; i++) {
+        long long quantum = static_cast<long long>(timeQuantum) * (1LL << i);
+        if (quantum > numeric_limits<int>::max()) {
+            throw invalid_argument("Time quantum too large: doubling " + to_string(timeQuantum) +
+                                   " gives level " + to_string(i) + " a quantum of " + to_string(quantum) +
+                                   ", more than " + to_string(numeric_limits<int>::max()));
+        }
+        quanta.push_back(static_cast<int>(quantum));
+    }
+    return quanta;
+}
+
+int MLFQScheduler::defaultBoostPeriod(const vector<int>& quanta) {
+    if (quanta.empty()) {
+        return 0;
+    }
+    long long period = static_cast<long long>(DEFAULT_BOOST_QUANTA) * quanta.back();
+    if (period > numeric_limits<int>::max()) {
+        throw invalid_argument("Time quantum too large: the default boost period of " +
+                               to_string(DEFAULT_BOOST_QUANTA) + " bottom-level quanta of " +
+                               to_string(quanta.back()) + " would be " + to_string(period) +
+                               ", more than " + to_string(numeric_limits<int>::max()));
+    }
+    return static_cast<int>(period);
+}
+
+void MLFQScheduler::setTimeQuantum(int timeQuantum) {
+    vector<int> quanta = doublingQuanta(timeQuantum);
+    setLevels(quanta, defaultBoostPeriod(quanta));
+}
+
+void MLFQScheduler::resetReadyQueue(size_t capacity) {
+    readyQueues.resize(readyQueueCount());
+    for (auto& readyQueue : readyQueues) {
+        readyQueue.reset(capacity);
+    }
+    renew(level);
+    renew(quantumEnd);
+    renew(boostedIn);
+    level.assign(capacity, 0);
+    quantumEnd.assign(capacity, 0);
+    boostedIn.assign(capacity, 0);
+    epoch = 0;
+    nextBoost = boostPeriod > 0 ? boostPeriod : numeric_limits<long long>::max();
+}
+
+void MLFQScheduler::growReadyQueue(size_t capacity) {
+    for (auto& readyQueue : readyQueues) {
+        readyQueue.grow(capacity);
+    }
+    if (capacity > level.size()) {
+        level.resize(capacity, 0);
+        quantumEnd.resize(capacity, 0);
+        boostedIn.resize(capacity, 0);
+    }
+}
+
+bool MLFQScheduler::boostDue() const {
+    return currentTime >= nextBoost;
+}
+
+void MLFQScheduler::boost() {
+    if (!boostDue()) {
+        return;
+    }
+    
+    // Queued processes move up by splicing the levels; their recorded
+    // levels, and those of the processes that were running, are corrected
+    // when they are next dispatched or requeued
+    for (auto& readyQueue : readyQueues) {
+        readyQueue.liftAll(0);
+    }
+    epoch++;
+    nextBoost = currentTime - currentTime % boostPeriod + boostPeriod;
+}
+
+void MLFQScheduler::startLevel(uint32_t pid, int newLevel) {
+    level[pid] = newLevel;
+    quantumEnd[pid] = jobs.remaining[pid] - quanta[newLevel];
+    boostedIn[pid] = epoch;
+}
+
+void MLFQScheduler::enqueue(uint32_t pid, size_t queue) {
+    boost();
+    startLevel(pid, 0);
+    readyQueues[queue].pushBack(pid, 0);
+}
+
+void MLFQScheduler::requeue(uint32_t pid, size_t queue) {
+    boost();
+    PriorityRunQueue& readyQueue = readyQueues[queue];
+    
+    if (boostedIn[pid] != epoch) {
+        // Its slice ended at a boost: it joins the others at the top level
+        startLevel(pid, 0);
+        readyQueue.pushBack(pid, 0);
+        return;
+    }
+    
+    int remaining = jobs.remaining[pid];
+    if (remaining > quantumEnd[pid]) {
+        // Preempted from a lower level with quantum to spare: it goes back
+        // to the front of its level
+        readyQueue.pushFront(pid, level[pid]);
+        return;
+    }
+    
+    // A slice with nobody else waiting may have run through several
+    // quanta; charge the excess down the levels, and around the bottom one
+    int bottom = static_cast<int>(quanta.size()) - 1;
+    int excess = quantumEnd[pid] - remaining;
+    int newLevel = min(level[pid] + 1, bottom);
+    while (newLevel < bottom && excess >= quanta[newLevel]) {
+        excess -= quanta[newLevel];
+        newLevel++;
+    }
+    excess %= quanta[newLevel];
+    
+    level[pid] = newLevel;
+    quantumEnd[pid] = remaining - (quanta[newLevel] - excess);
+    if (excess > 0) {
+        // Part way into its new quantum, and queued there before anything
+        // that has joined the level since
+        readyQueue.pushFront(pid, newLevel);
+    } else {
+        readyQueue.pushBack(pid, newLevel);
+    }
+}
+
+uint32_t MLFQScheduler::dequeue(size_t queue) {
+    boost();
+    PriorityRunQueue& readyQueue = readyQueues[queue];
+    if (readyQueue.empty()) {
+        return NO_PID;
+    }
+    
+    uint32_t pid = static_cast<uint32_t>(readyQueue.pop());
+    if (boostedIn[pid] != epoch) {
+        startLevel(pid, 0);
+    }
+    return pid;
+}
+
+int MLFQScheduler::sliceLength(uint32_t running, size_t queue) const {
+    // With nobody waiting, run straight through quantum boundaries until
+    // the next arrival or completion; requeue() settles the quanta used.
+    // Other CPUs only ever take from this queue, so it stays empty until then.
+    int remaining = jobs.remaining[running];
+    int slice = remaining;
+    if (!readyQueues[queue].empty()) {
+        slice = min(remaining, remaining - quantumEnd[running]);
+    }
+    
+    // Every CPU stops at the next boost, so it happens on time
+    return static_cast<int>(min<long long>(slice, nextBoost - currentTime));
+}
+
+bool MLFQScheduler::preemptsOnArrival() const {
+    return true;
+}
+
+bool MLFQScheduler::shouldPreempt(uint32_t running, size_t queue) const {
+    // A boost or a used-up quantum always sends the process back through
+    // requeue(), which finds its new level
+    if (boostDue() || boostedIn[running] != epoch || jobs.remaining[running] <= quantumEnd[running]) {
+        return true;
+    }
+    
+    const PriorityRunQueue& readyQueue = readyQueues[queue];
+    return !readyQueue.empty() && readyQueue.topPriority() < level[running];
+}
+
+string MLFQScheduler::getName() const {
+    return "Multi-Level Feedback Queue (MLFQ)";
+}
+
+string MLFQScheduler::getDescription() const {
+    return "A preemptive scheduling algorithm with several Round Robin queues of increasing time quantum. "
+           "New processes start in the top queue and drop a level each time they use up a whole quantum, "
+           "so short interactive jobs finish quickly while long jobs sink; a periodic boost returns every process to the top queue.";
+}
\ No newline at end of file
@@ -0,0 +1,171 @@
+#ifndef MLFQ_SCHEDULER_H
+#define MLFQ_SCHEDULER_H
+
+#include "scheduler.h"
+#include "priority_run_queue.h"
+
+/**
+ * @class MLFQScheduler
+ * @brief Multi-Level Feedback Queue scheduling algorithm implementation
+ * 
+ * New processes start in the top level. A process that uses up the
+ * quantum of its level drops one level, and the bottom level is plain
+ * Round Robin. A process in a higher level preempts one in a lower level,
+ * and the preempted process keeps its place and what is left of its
+ * quantum. Every boost period all processes return to the top level, so
+ * long jobs cannot starve behind a stream of short ones.
+ * 
+ * Each ready queue is a PriorityRunQueue with one level per MLFQ level,
+ * so queueing is O(1) and a boost splices the levels together in
+ * O(levels). The quantum of a process is kept as the remaining time at
+ * which it runs out, so a slice may span several quanta when nothing else
+ * is waiting, and the demotions it earned are settled in O(levels) when
+ * the process leaves the CPU. Slices end at every multiple of the boost
+ * period; the processes that were running then join the top level behind
+ * those that were waiting.
+ */
+class MLFQScheduler : public Scheduler {
+private:
+    vector<int> quanta;                       // Time quantum of each level, top level first
+    int boostPeriod;                          // Time between boosts, or 0 for none
+    vector<PriorityRunQueue> readyQueues;     // Ready processes by level, one per ready queue
+    ScratchVector<int> level;                 // Current level of each process
+    ScratchVector<int> quantumEnd;            // Remaining time at which each process's quantum runs out
+    ScratchVector<uint32_t> boostedIn;        // Boost epoch in which each level was last set
+    uint32_t epoch;                           // Boosts performed in this run
+    long long nextBoost;                      // Time of the next boost
+    
+    bool boostDue() const;
+    void boost();
+    void startLevel(uint32_t pid, int newLevel);
+
+public:
+    static const int DEFAULT_LEVELS = 3;         // Levels made from a single time quantum
+    static const int DEFAULT_BOOST_QUANTA = 10;  // Default boost period in bottom-level quanta
+    
+    /**
+     * @brief Gets the default levels for a time quantum
+     * @param timeQuantum Top-level quantum
+     * @return DEFAULT_LEVELS quanta, each double the one above
+     * 
+     * Throws invalid_argument if the bottom quantum would not fit in an int.
+     */
+    static vector<int> doublingQuanta(int timeQuantum);
+    
+    /**
+     * @brief Gets the default boost period for some levels
+     * @param quanta Time quantum of each level, top level first
+     * @return DEFAULT_BOOST_QUANTA bottom-level quanta
+     * 
+     * Throws invalid_argument if the period would not fit in an int.
+     */
+    static int defaultBoostPeriod(const vector<int>& quanta);
+    
+    /**
+     * @brief Constructor for MLFQScheduler
+     * @param processes List of processes to schedule
+     * @param timeQuantum Top-level quantum; each lower level doubles it
+     */
+    MLFQScheduler(const vector<Process>& processes, int timeQuantum);
+    
+    /**
+     * @brief Constructor for MLFQScheduler
+     * @param table Process table to schedule
+     * @param timeQuantum Top-level quantum; each lower level doubles it
+     */
+    MLFQScheduler(const ProcessTable& table, int timeQuantum);
+    
+    /**
+     * @brief Constructor for MLFQScheduler
+     * @param table Process table to schedule
+     * @param quanta Time quantum of each level, top level first
+     * @param boostPeriod Time between boosts to the top level, or 0 for none
+     */
+    MLFQScheduler(const ProcessTable& table, const vector<int>& quanta, int boostPeriod);
+    
+    /**
+     * @brief Changes the levels for later runs
+     * @param quanta Time quantum of each level, top level first
+     * @param boostPeriod Time between boosts to the top level, or 0 for none
+     * 
+     * Throws invalid_argument unless there are 1 to PriorityRunQueue::LEVELS
+     * quanta, each at least 1, and the period is not negative.
+     */
+    void setLevels(const vector<int>& quanta, int boostPeriod);
+    
+    /**
+     * @brief Changes the levels for later runs to the defaults for a quantum
+     * @param timeQuantum Top-level quantum; each lower level doubles it
+     */
+    void setTimeQuantum(int timeQuantum);
+    
+    /**
+     * @brief Gets the name of the scheduling algorithm
+     * @return String name of the algorithm
+     */
+    string getName() const override;
+    
+    /**
+     * @brief Gets the description of the scheduling algorithm
+     * @return String description of the algorithm
+     */
+    string getDescription() const override;
+
+protected:
+    /**
+     * @brief Empties the ready queues, sizes them for PIDs below capacity and restarts the boost clock
+     * @param capacity One past the largest PID that will be enqueued
+     */
+    void resetReadyQueue(size_t capacity) override;
+    
+    /**
+     * @brief Sizes the ready queues for PIDs below capacity, keeping their contents
+     * @param capacity New upper bound on PIDs
+     */
+    void growReadyQueue(size_t capacity) override;
+    
+    /**
+     * @brief Adds a newly arrived process to the top level
+     * @param pid Process that has just arrived
+     * @param queue Ready queue to add it to
+     */
+    void enqueue(uint32_t pid, size_t queue) override;
+    
+    /**
+     * @brief Returns a preempted process to a ready queue, one level down if it used up its quantum
+     * @param pid Process that was taken off the CPU
+     * @param queue Ready queue of the CPU it ran on
+     */
+    void requeue(uint32_t pid, size_t queue) override;
+    
+    /**
+     * @brief Removes and returns the first process of the highest non-empty level
+     * @param queue Ready queue to take it from
+     * @return Next process, or NO_PID if the ready queue is empty
+     */
+    uint32_t dequeue(size_t queue) override;
+    
+    /**
+     * @brief Gets how long the running process may execute before the next decision
+     * @param running Process currently on the CPU
+     * @param queue Ready queue of the CPU it runs on
+     * @return Slice length
+     */
+    int sliceLength(uint32_t running, size_t queue) const override;
+    
+    /**
+     * @brief Whether a slice must end at the next arrival so preemption can be checked
+     * @return True, since arrivals enter above every lower level
+     */
+    bool preemptsOnArrival() const override;
+    
+    /**
+     * @brief Decides at a slice boundary whether the running process gives up the CPU
+     * @param running Process currently on the CPU
+     * @param queue Ready queue of the CPU it runs on
+     * @return True if the running process should be preempted
+     */
+    bool shouldPreempt(uint32_t running, size_t queue) const override;
+};
+
+#endif // MLFQ_SCHEDULER_H
\ No newline at end of file
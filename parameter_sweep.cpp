@@ -0,0 +1,269 @@
+#include "parameter_sweep.h"
+#include "fcfs_scheduler.h"
+#include "sjf_scheduler.h"
+#include "rr_scheduler.h"
+#include "priority_scheduler.h"
+#include "ljf_scheduler.h"
+#include "hrrn_scheduler.h"
+#include "mlfq_scheduler.h"
+#include <algorithm>
+#include <exception>
+#include <iomanip>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    const char* const ALGORITHMS[] = {"fcfs", "sjf", "ljf", "priority", "rr", "hrrn", "mlfq"};
+    
+    bool takesQuantum(const string& algorithm) {
+        return algorithm == "rr" || algorithm == "mlfq";
+    }
+    
+    bool takesPreemptive(const string& algorithm) {
+        return algorithm == "sjf" || algorithm == "ljf" || algorithm == "priority";
+    }
+    
+    // Schedulers owned by one worker for the whole sweep, built on first use
+    struct SweepWorker {
+        unique_ptr<FCFSScheduler> fcfs;
+        unique_ptr<SJFScheduler> sjf;
+        unique_ptr<SRTFScheduler> srtf;
+        unique_ptr<LJFScheduler> ljf;
+        unique_ptr<LRTFScheduler> lrtf;
+        unique_ptr<PriorityScheduler> priority;
+        unique_ptr<PreemptivePriorityScheduler> preemptivePriority;
+        unique_ptr<RRScheduler> rr;
+        unique_ptr<HRRNScheduler> hrrn;
+        unique_ptr<MLFQScheduler> mlfq;
+        
+        // Preemption is part of each key scheduler's type, so either mode has its own instance
+        template <typename T>
+        static Scheduler& reuse(unique_ptr<T>& scheduler, const ProcessTable& workload) {
+            if (!scheduler) {
+                scheduler.reset(new T(workload));
+            }
+            return *scheduler;
+        }
+        
+        Scheduler& configure(const SweepConfig& config, const ProcessTable& workload) {
+            const string& algorithm = config.algorithm;
+            if (algorithm == "fcfs") {
+                return reuse(fcfs, workload);
+            }
+            if (algorithm == "sjf") {
+                return config.preemptive ? reuse(srtf, workload) : reuse(sjf, workload);
+            }
+            if (algorithm == "ljf") {
+                return config.preemptive ? reuse(lrtf, workload) : reuse(ljf, workload);
+            }
+            if (algorithm == "priority") {
+                return config.preemptive ? reuse(preemptivePriority, workload) : reuse(priority, workload);
+            }
+            if (algorithm == "rr") {
+                if (!rr) {
+                    rr.reset(new RRScheduler(workload, config.timeQuantum));
+                }
+                rr->setTimeQuantum(config.timeQuantum);
+                return *rr;
+            }
+            if (algorithm == "mlfq") {
+                if (!mlfq) {
+                    mlfq.reset(new MLFQScheduler(workload, config.timeQuantum));
+                }
+                mlfq->setTimeQuantum(config.timeQuantum);
+                return *mlfq;
+            }
+            return reuse(hrrn, workload);
+        }
+    };
+    
+    int parseBound(const string& text, const string& range) {
+        size_t used = 0;
+        int value = 0;
+        try {
+            value = stoi(text, &used);
+        } catch (const exception&) {
+            used = 0;
+        }
+        if (text.empty() || used != text.size()) {
+            throw invalid_argument("Invalid range '" + range + "'");
+        }
+        return value;
+    }
+}
+
+ParameterSweep::ParameterSweep(size_t threads)
+    : algorithms(begin(ALGORITHMS), end(ALGORITHMS)), quanta(1, 2), preemptive{false, true},
+      cpus(1), queueMode(PER_CPU_QUEUES), pool(threads) {}
+
+void ParameterSweep::setAlgorithms(const vector<string>& names) {
+    for (const auto& name : names) {
+        if (find(begin(ALGORITHMS), end(ALGORITHMS), name) == end(ALGORITHMS)) {
+            throw invalid_argument("Unknown algorithm '" + name + "'");
+        }
+    }
+    algorithms = names;
+}
+
+void ParameterSweep::setQuanta(const vector<int>& values) {
+    for (int quantum : values) {
+        if (quantum < 1) {
+            throw invalid_argument("Time quantum must be at least 1");
+        }
+    }
+    quanta = values;
+}
+
+void ParameterSweep::setPreemptive(const vector<bool>& values) {
+    preemptive = values;
+}
+
+void ParameterSweep::setCpus(size_t count, QueueMode mode) {
+    if (count < 1) {
+        throw invalid_argument("A sweep needs at least one CPU");
+    }
+    cpus = count;
+    queueMode = mode;
+}
+
+vector<SweepConfig> ParameterSweep::configurations() const {
+    vector<SweepConfig> configs;
+    for (const auto& algorithm : algorithms) {
+        if (takesQuantum(algorithm)) {
+            for (int quantum : quanta) {
+                configs.push_back({algorithm, quantum, true});
+            }
+        } else if (takesPreemptive(algorithm)) {
+            for (bool mode : preemptive) {
+                configs.push_back({algorithm, 0, mode});
+            }
+        } else {
+            configs.push_back({algorithm, 0, false});
+        }
+    }
+    return configs;
+}
+
+vector<SweepRow> ParameterSweep::run(const ProcessTable& workload) {
+    vector<SweepConfig> configs = configurations();
+    vector<SweepRow> rows(configs.size());
+    vector<exception_ptr> errors(configs.size());
+    vector<SweepWorker> workers(pool.size());
+    
+    // Each call writes only its own row and uses only its worker's schedulers
+    pool.parallelFor(configs.size(), [&](size_t index, size_t worker) {
+        try {
+            Scheduler& scheduler = workers[worker].configure(configs[index], workload);
+            scheduler.setCpus(cpus, queueMode);
+            rows[index].config = configs[index];
+            rows[index].algorithmName = scheduler.getName();
+            rows[index].result = scheduler.run();
+            
+            // Hundreds of Gantt charts and per-process times would dwarf the
+            // metrics, so their buffers go back to the scheduler for its next run
+            SchedulerResult& result = rows[index].result;
+            SchedulerResult spent;
+            spent.ganttChart.swap(result.ganttChart);
+            spent.cpus.swap(result.cpus);
+            spent.completions.swap(result.completions);
+            spent.responses.swap(result.responses);
+            scheduler.recycle(move(spent));
+        } catch (...) {
+            errors[index] = current_exception();
+        }
+    });
+    
+    for (const auto& error : errors) {
+        if (error) {
+            rethrow_exception(error);
+        }
+    }
+    return rows;
+}
+
+vector<int> ParameterSweep::parseRange(const string& text) {
+    vector<int> values;
+    stringstream parts(text);
+    string part;
+    while (getline(parts, part, ',')) {
+        vector<string> bounds;
+        stringstream fields(part);
+        string field;
+        while (getline(fields, field, ':')) {
+            bounds.push_back(field);
+        }
+        if (bounds.empty() || bounds.size() > 3) {
+            throw invalid_argument("Invalid range '" + text + "'");
+        }
+        
+        int first = parseBound(bounds[0], text);
+        int last = bounds.size() > 1 ? parseBound(bounds[1], text) : first;
+        int step = bounds.size() > 2 ? parseBound(bounds[2], text) : 1;
+        if (step < 1 || last < first) {
+            throw invalid_argument("Invalid range '" + text + "'");
+        }
+        for (long long value = first; value <= last; value += step) {
+            values.push_back(static_cast<int>(value));
+        }
+    }
+    
+    if (values.empty()) {
+        throw invalid_argument("Invalid range '" + text + "'");
+    }
+    return values;
+}
+
+void ParameterSweep::writeTable(ostream& out, const vector<SweepRow>& rows) {
+    out << left << setw(10) << "Algorithm" << right
+        << setw(9) << "Quantum" << setw(12) << "Preemptive"
+        << setw(12) << "Turnaround" << setw(10) << "Waiting" << setw(10) << "Response"
+        << setw(12) << "Throughput" << setw(9) << "CPU %" << "\n";
+    
+    for (const auto& row : rows) {
+        const SweepConfig& config = row.config;
+        out << left << setw(10) << config.algorithm << right
+            << setw(9) << (takesQuantum(config.algorithm) ? to_string(config.timeQuantum) : "-")
+            << setw(12) << (takesPreemptive(config.algorithm) ? (config.preemptive ? "yes" : "no") : "-")
+            << fixed << setprecision(2)
+            << setw(12) << row.result.avgTurnaroundTime
+            << setw(10) << row.result.avgWaitingTime
+            << setw(10) << row.result.avgResponseTime
+            << setprecision(4) << setw(12) << row.result.throughput
+            << setprecision(2) << setw(9) << row.result.cpuUtilization << "\n";
+    }
+}
+
+void ParameterSweep::writeCsv(ostream& out, const vector<SweepRow>& rows) {
+    out << "algorithm,quantum,preemptive,avg_turnaround,avg_waiting,avg_response,throughput,cpu_utilization\n";
+    out << setprecision(10);
+    for (const auto& row : rows) {
+        const SweepConfig& config = row.config;
+        out << config.algorithm << ","
+            << (takesQuantum(config.algorithm) ? to_string(config.timeQuantum) : "") << ","
+            << (takesPreemptive(config.algorithm) ? (config.preemptive ? "1" : "0") : "") << ","
+            << row.result.avgTurnaroundTime << "," << row.result.avgWaitingTime << ","
+            << row.result.avgResponseTime << "," << row.result.throughput << ","
+            << row.result.cpuUtilization << "\n";
+    }
+}
+
+void ParameterSweep::writeJson(ostream& out, const vector<SweepRow>& rows) {
+    out << "[" << setprecision(10);
+    for (size_t i = 0; i < rows.size(); i++) {
+        const SweepConfig& config = rows[i].config;
+        const SchedulerResult& result = rows[i].result;
+        out << (i == 0 ? "\n  {" : ",\n  {")
+            << "\"algorithm\": \"" << config.algorithm << "\", \"name\": \"" << rows[i].algorithmName << "\""
+            << ", \"quantum\": " << (takesQuantum(config.algorithm) ? to_string(config.timeQuantum) : "null")
+            << ", \"preemptive\": "
+            << (takesPreemptive(config.algorithm) ? (config.preemptive ? "true" : "false") : "null")
+            << ", \"avg_turnaround\": " << result.avgTurnaroundTime
+            << ", \"avg_waiting\": " << result.avgWaitingTime
+            << ", \"avg_response\": " << result.avgResponseTime
+            << ", \"throughput\": " << result.throughput
+            << ", \"cpu_utilization\": " << result.cpuUtilization << "}";
+    }
+    out << (rows.empty() ? "]\n" : "\n]\n");
+}
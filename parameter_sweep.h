@@ -0,0 +1,138 @@
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include "process_table.h"
+#include "scheduler.h"
+#include "thread_pool.h"
+
+using namespace std;
+
+/**
+ * @struct SweepConfig
+ * @brief One point of a parameter sweep
+ */
+struct SweepConfig {
+    string algorithm;  // fcfs, sjf, ljf, priority, rr, hrrn or mlfq
+    int timeQuantum;   // Time quantum for rr, top-level quantum for mlfq, 0 for other algorithms
+    bool preemptive;   // Preemptive mode for sjf, ljf and priority
+};
+
+/**
+ * @struct SweepRow
+ * @brief Metrics of one configuration
+ */
+struct SweepRow {
+    SweepConfig config;      // Configuration that was run
+    string algorithmName;    // Scheduler::getName() of the configured scheduler
+    SchedulerResult result;  // Metrics of the run; the Gantt chart and per-process times are dropped
+};
+
+/**
+ * @class ParameterSweep
+ * @brief Runs every combination of algorithm parameters on one workload in parallel
+ * 
+ * The sweep is the cross product of the chosen algorithms with the
+ * parameters each one takes: Round Robin and MLFQ with every time quantum,
+ * SJF, LJF and Priority with every preemption mode, FCFS and HRRN once. Runs are
+ * spread over the pool with work stealing. Each worker keeps one scheduler
+ * per algorithm for the whole sweep and only reconfigures it between runs,
+ * so the per-run state is allocated once per worker rather than once per
+ * configuration.
+ */
+class ParameterSweep {
+private:
+    vector<string> algorithms;  // Algorithms to sweep, in output order
+    vector<int> quanta;         // Round Robin time quanta and MLFQ top-level quanta
+    vector<bool> preemptive;    // Preemption modes
+    size_t cpus;                // Simulated CPUs in every run
+    QueueMode queueMode;        // How those CPUs share ready processes
+    ThreadPool pool;            // Workers that run the configurations
+
+public:
+    /**
+     * @brief Constructor for ParameterSweep
+     * @param threads Number of worker threads, or 0 for one per hardware thread
+     * 
+     * Defaults to every algorithm, quantum 2, both preemption modes and
+     * one CPU.
+     */
+    explicit ParameterSweep(size_t threads = 0);
+    
+    /**
+     * @brief Sets the algorithms to sweep
+     * @param names Algorithm keys: fcfs, sjf, ljf, priority, rr, hrrn or mlfq
+     * 
+     * Throws invalid_argument for an unknown key.
+     */
+    void setAlgorithms(const vector<string>& names);
+    
+    /**
+     * @brief Sets the Round Robin time quanta and MLFQ top-level quanta to try
+     * @param values Quanta, each at least 1
+     */
+    void setQuanta(const vector<int>& values);
+    
+    /**
+     * @brief Sets the preemption modes to try for SJF, LJF and Priority
+     * @param values Any of false and true
+     */
+    void setPreemptive(const vector<bool>& values);
+    
+    /**
+     * @brief Sets the simulated CPUs every configuration runs on
+     * @param count Number of CPUs, at least 1
+     * @param mode Whether the CPUs share one ready queue or each have their own
+     */
+    void setCpus(size_t count, QueueMode mode);
+    
+    /**
+     * @brief Lists the configurations a run() would execute
+     * @return Configurations in output order
+     */
+    vector<SweepConfig> configurations() const;
+    
+    /**
+     * @brief Runs every configuration on a workload
+     * @param workload Workload shared read-only by all runs
+     * @return One row per configuration, in the order of configurations()
+     * 
+     * If a run throws, the first failing configuration's exception is
+     * rethrown once all runs have finished.
+     */
+    vector<SweepRow> run(const ProcessTable& workload);
+    
+    /**
+     * @brief Parses an inclusive integer range
+     * @param text "N", "FIRST:LAST" or "FIRST:LAST:STEP", or a comma-separated list of them
+     * @return Values in the order given
+     * 
+     * Throws invalid_argument if the text is not a valid range.
+     */
+    static vector<int> parseRange(const string& text);
+    
+    /**
+     * @brief Writes rows as an aligned text table
+     * @param out Stream to write to
+     * @param rows Rows from run()
+     */
+    static void writeTable(ostream& out, const vector<SweepRow>& rows);
+    
+    /**
+     * @brief Writes rows as CSV with a header line
+     * @param out Stream to write to
+     * @param rows Rows from run()
+     */
+    static void writeCsv(ostream& out, const vector<SweepRow>& rows);
+    
+    /**
+     * @brief Writes rows as a JSON array with one object per configuration
+     * @param out Stream to write to
+     * @param rows Rows from run()
+     */
+    static void writeJson(ostream& out, const vector<SweepRow>& rows);
+};
+
+#endif // PARAMETER_SWEEP_H
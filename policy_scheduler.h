@@ -0,0 +1,277 @@
+#ifndef POLICY_SCHEDULER_H
+#define POLICY_SCHEDULER_H
+
+#include <type_traits>
+#include "scheduler.h"
+#include "scheduler_loop.h"
+#include "indexed_heap.h"
+#include "priority_run_queue.h"
+
+/**
+ * @struct NonPreemptive
+ * @brief Preemption policy for PolicyScheduler: a dispatched process runs to completion
+ */
+struct NonPreemptive {
+    static const bool ENABLED = false;
+};
+
+/**
+ * @struct Preemptive
+ * @brief Preemption policy for PolicyScheduler: a waiting process that comes first takes the CPU
+ */
+struct Preemptive {
+    static const bool ENABLED = true;
+};
+
+/**
+ * @struct KeyOrder
+ * @brief Ready-queue ordering of a key policy: smaller key first, then earlier arrival
+ * @tparam KeyPolicy Policy whose key() orders the processes
+ */
+template <typename KeyPolicy>
+struct KeyOrder {
+    const JobState* jobs;       // Run state, for keys that depend on it
+    const ProcessTable* table;  // Table whose PIDs are ordered
+    
+    bool operator()(size_t a, size_t b) const {
+        int keyA = KeyPolicy::key(static_cast<uint32_t>(a), *jobs, *table);
+        int keyB = KeyPolicy::key(static_cast<uint32_t>(b), *jobs, *table);
+        if (keyA != keyB) {
+            return keyA < keyB;
+        }
+        return table->sequence[a] < table->sequence[b];
+    }
+};
+
+/**
+ * @class PolicyScheduler
+ * @brief Scheduler that always runs the process with the smallest key, specialized at compile time
+ * 
+ * A KeyPolicy is a struct with:
+ *   static int key(uint32_t pid, const JobState& jobs, const ProcessTable& table)
+ *       Sort key of a process; the smallest runs first, ties go to the
+ *       earlier arrival
+ *   static const bool FIXED_KEY
+ *       Whether keys never change during a run. Fixed keys are kept in a
+ *       PriorityRunQueue, FIFO per key: a preempted process goes back to
+ *       the front of its level and only a strictly smaller key preempts.
+ *       Other keys are kept in an IndexedHeap.
+ *   static const bool RUNNING_KEY_GROWS
+ *       Whether the running process's key grows by one per unit of CPU
+ *       time, so that a waiting process can overtake it mid-slice
+ *   static string name(bool preemptive), description(bool preemptive)
+ * 
+ * The Preemption policy is NonPreemptive or Preemptive. Both policies are
+ * compile-time constants, so the key is read inline in every comparison
+ * and checks of the other mode vanish. The class is final and hands the
+ * event loop its own type, so the loop calls its hooks directly.
+ * 
+ * @tparam KeyPolicy Ordering of the ready processes
+ * @tparam Preemption Whether a waiting process can take the CPU
+ */
+template <typename KeyPolicy, typename Preemption>
+class PolicyScheduler final : public Scheduler {
+    friend class Scheduler;  // The event loop calls the hooks through this type
+
+private:
+    typedef KeyOrder<KeyPolicy> Order;
+    typedef typename conditional<KeyPolicy::FIXED_KEY, PriorityRunQueue, IndexedHeap<Order>>::type ReadyQueue;
+    
+    vector<ReadyQueue> readyQueues; // Arrived processes waiting for the CPU, one per ready queue
+    
+    int key(uint32_t pid) const {
+        return KeyPolicy::key(pid, jobs, *table);
+    }
+    
+    void resetQueue(IndexedHeap<Order>& readyQueue, size_t capacity) {
+        readyQueue.reset(capacity, Order{&jobs, table});
+    }
+    
+    void resetQueue(PriorityRunQueue& readyQueue, size_t capacity) {
+        readyQueue.reset(capacity);
+    }
+    
+    void push(IndexedHeap<Order>& readyQueue, uint32_t pid, bool /*preempted*/) {
+        readyQueue.push(pid);
+    }
+    
+    void push(PriorityRunQueue& readyQueue, uint32_t pid, bool preempted) {
+        // Arrivals come in arrival order, so FIFO within a level keeps the
+        // earlier-arrival tie-break; a preempted process was ahead of
+        // everything still waiting at its level
+        if (preempted) {
+            readyQueue.pushFront(pid, key(pid));
+        } else {
+            readyQueue.pushBack(pid, key(pid));
+        }
+    }
+
+public:
+    /**
+     * @brief Constructor for PolicyScheduler
+     * @param processes List of processes to schedule
+     */
+    PolicyScheduler(const vector<Process>& processes) : Scheduler(processes) {}
+    
+    /**
+     * @brief Constructor for PolicyScheduler
+     * @param table Process table to schedule
+     */
+    PolicyScheduler(const ProcessTable& table) : Scheduler(table) {}
+    
+    /**
+     * @brief Gets the name of the scheduling algorithm
+     * @return String name of the algorithm
+     */
+    string getName() const override {
+        return KeyPolicy::name(Preemption::ENABLED);
+    }
+    
+    /**
+     * @brief Gets the description of the scheduling algorithm
+     * @return String description of the algorithm
+     */
+    string getDescription() const override {
+        return KeyPolicy::description(Preemption::ENABLED);
+    }
+
+protected:
+    /**
+     * @brief Runs the event loop with this exact type as the hooks
+     * @return SchedulerResult containing all metrics
+     */
+    SchedulerResult simulateRun() override;
+    
+    /**
+     * @brief Empties the ready queues and sizes them for PIDs below capacity
+     * @param capacity One past the largest PID that will be enqueued
+     */
+    void resetReadyQueue(size_t capacity) override;
+    
+    /**
+     * @brief Sizes the ready queues for PIDs below capacity, keeping their contents
+     * @param capacity New upper bound on PIDs
+     */
+    void growReadyQueue(size_t capacity) override;
+    
+    /**
+     * @brief Adds a newly arrived process to the ready queue
+     * @param pid Process that has just arrived
+     * @param queue Ready queue to add it to
+     */
+    void enqueue(uint32_t pid, size_t queue) override;
+    
+    /**
+     * @brief Returns a preempted process to a ready queue
+     * @param pid Process that was taken off the CPU
+     * @param queue Ready queue of the CPU it ran on
+     */
+    void requeue(uint32_t pid, size_t queue) override;
+    
+    /**
+     * @brief Removes and returns the next process to dispatch from a ready queue
+     * @param queue Ready queue to take it from
+     * @return Next process, or NO_PID if the ready queue is empty
+     */
+    uint32_t dequeue(size_t queue) override;
+    
+    /**
+     * @brief Gets how long the running process may execute before the next decision
+     * @param running Process currently on the CPU
+     * @param queue Ready queue of the CPU it runs on
+     * @return Slice length
+     */
+    int sliceLength(uint32_t running, size_t queue) const override;
+    
+    /**
+     * @brief Whether a slice must end at the next arrival so preemption can be checked
+     * @return True with the Preemptive policy
+     */
+    bool preemptsOnArrival() const override;
+    
+    /**
+     * @brief Decides at a slice boundary whether the running process gives up the CPU
+     * @param running Process currently on the CPU
+     * @param queue Ready queue of the CPU it runs on
+     * @return True if the running process should be preempted
+     */
+    bool shouldPreempt(uint32_t running, size_t queue) const override;
+};
+
+template <typename KeyPolicy, typename Preemption>
+SchedulerResult PolicyScheduler<KeyPolicy, Preemption>::simulateRun() {
+    return cpuCount > 1 ? simulateMultiCore(*this) : simulate(*this);
+}
+
+template <typename KeyPolicy, typename Preemption>
+void PolicyScheduler<KeyPolicy, Preemption>::resetReadyQueue(size_t capacity) {
+    // Point the ordering at the table and state of this run
+    readyQueues.resize(readyQueueCount());
+    for (auto& readyQueue : readyQueues) {
+        resetQueue(readyQueue, capacity);
+    }
+}
+
+template <typename KeyPolicy, typename Preemption>
+void PolicyScheduler<KeyPolicy, Preemption>::growReadyQueue(size_t capacity) {
+    for (auto& readyQueue : readyQueues) {
+        readyQueue.grow(capacity);
+    }
+}
+
+template <typename KeyPolicy, typename Preemption>
+void PolicyScheduler<KeyPolicy, Preemption>::enqueue(uint32_t pid, size_t queue) {
+    push(readyQueues[queue], pid, false);
+}
+
+template <typename KeyPolicy, typename Preemption>
+void PolicyScheduler<KeyPolicy, Preemption>::requeue(uint32_t pid, size_t queue) {
+    push(readyQueues[queue], pid, true);
+}
+
+template <typename KeyPolicy, typename Preemption>
+uint32_t PolicyScheduler<KeyPolicy, Preemption>::dequeue(size_t queue) {
+    if (readyQueues[queue].empty()) {
+        return NO_PID;
+    }
+    
+    return static_cast<uint32_t>(readyQueues[queue].pop());
+}
+
+template <typename KeyPolicy, typename Preemption>
+int PolicyScheduler<KeyPolicy, Preemption>::sliceLength(uint32_t running, size_t queue) const {
+    const ReadyQueue& readyQueue = readyQueues[queue];
+    if (!Preemption::ENABLED || !KeyPolicy::RUNNING_KEY_GROWS || readyQueue.empty()) {
+        return jobs.remaining[running];
+    }
+    
+    // Waiting keys stay put while the running key grows, so run exactly
+    // until the best waiting process would overtake it
+    uint32_t best = static_cast<uint32_t>(readyQueue.top());
+    int gap = key(best) - key(running);
+    return table->sequence[best] < table->sequence[running] ? gap : gap + 1;
+}
+
+template <typename KeyPolicy, typename Preemption>
+bool PolicyScheduler<KeyPolicy, Preemption>::preemptsOnArrival() const {
+    return Preemption::ENABLED;
+}
+
+template <typename KeyPolicy, typename Preemption>
+bool PolicyScheduler<KeyPolicy, Preemption>::shouldPreempt(uint32_t running, size_t queue) const {
+    const ReadyQueue& readyQueue = readyQueues[queue];
+    if (!Preemption::ENABLED || readyQueue.empty()) {
+        return false;
+    }
+    
+    // The top of the queue is the only waiting process that can beat the
+    // running one. With fixed keys, anything waiting at the same level
+    // arrived after the running process, so only a strictly smaller key wins.
+    uint32_t best = static_cast<uint32_t>(readyQueue.top());
+    if (KeyPolicy::FIXED_KEY) {
+        return key(best) < key(running);
+    }
+    return Order{&jobs, table}(best, running);
+}
+
+#endif // POLICY_SCHEDULER_H
@@ -0,0 +1,178 @@
+#include "priority_run_queue.h"
+#include "scheduler_stats.h"
+
+const int PriorityRunQueue::LEVELS;
+const size_t PriorityRunQueue::NONE;
+
+PriorityRunQueue::PriorityRunQueue() : count(0) {
+    reset(0);
+}
+
+void PriorityRunQueue::reset(size_t capacity) {
+    for (int i = 0; i < WORDS; i++) {
+        bitmap[i] = 0;
+    }
+    for (int i = 0; i < LEVELS; i++) {
+        head[i] = NONE;
+        tail[i] = NONE;
+    }
+    renew(next);
+    next.assign(capacity, NONE);
+    sparse.clear();
+    count = 0;
+}
+
+void PriorityRunQueue::grow(size_t capacity) {
+    if (capacity > next.size()) {
+        next.resize(capacity, NONE);
+    }
+}
+
+bool PriorityRunQueue::empty() const {
+    return count == 0;
+}
+
+size_t PriorityRunQueue::size() const {
+    return count;
+}
+
+bool PriorityRunQueue::inRange(int priority) {
+    return priority >= 0 && priority < LEVELS;
+}
+
+int PriorityRunQueue::firstLevel() const {
+    for (int i = 0; i < WORDS; i++) {
+        INSTRUMENT(scannedEntries++;)
+        if (bitmap[i] != 0) {
+            return i * WORD_BITS + __builtin_ctzll(bitmap[i]);
+        }
+    }
+    return LEVELS;
+}
+
+int PriorityRunQueue::bestPriority() const {
+    // Sparse levels below 0 beat the bitmap, those above it only win when
+    // the bitmap is empty
+    int best = firstLevel();
+    if (!sparse.empty() && (sparse.begin()->first < 0 || best == LEVELS)) {
+        best = sparse.begin()->first;
+    }
+    return best;
+}
+
+void PriorityRunQueue::pushBack(size_t id, int priority) {
+    count++;
+    
+    if (!inRange(priority)) {
+        sparse[priority].push_back(id);
+        return;
+    }
+    
+    next[id] = NONE;
+    if (tail[priority] == NONE) {
+        head[priority] = id;
+        bitmap[priority / WORD_BITS] |= uint64_t(1) << (priority % WORD_BITS);
+    } else {
+        next[tail[priority]] = id;
+    }
+    tail[priority] = id;
+}
+
+void PriorityRunQueue::pushFront(size_t id, int priority) {
+    count++;
+    
+    if (!inRange(priority)) {
+        sparse[priority].push_front(id);
+        return;
+    }
+    
+    next[id] = head[priority];
+    if (head[priority] == NONE) {
+        tail[priority] = id;
+        bitmap[priority / WORD_BITS] |= uint64_t(1) << (priority % WORD_BITS);
+    }
+    head[priority] = id;
+}
+
+size_t PriorityRunQueue::top() const {
+    int priority = bestPriority();
+    if (!inRange(priority)) {
+        return sparse.at(priority).front();
+    }
+    return head[priority];
+}
+
+int PriorityRunQueue::topPriority() const {
+    return bestPriority();
+}
+
+size_t PriorityRunQueue::pop() {
+    count--;
+    int priority = bestPriority();
+    
+    if (!inRange(priority)) {
+        auto it = sparse.find(priority);
+        size_t id = it->second.front();
+        it->second.pop_front();
+        if (it->second.empty()) {
+            sparse.erase(it);
+        }
+        return id;
+    }
+    
+    size_t id = head[priority];
+    head[priority] = next[id];
+    if (head[priority] == NONE) {
+        tail[priority] = NONE;
+        bitmap[priority / WORD_BITS] &= ~(uint64_t(1) << (priority % WORD_BITS));
+    }
+    return id;
+}
+
+void PriorityRunQueue::liftAll(int priority) {
+    size_t first = NONE;
+    size_t last = NONE;
+    auto append = [&](size_t from, size_t to) {
+        if (first == NONE) {
+            first = from;
+        } else {
+            next[last] = from;
+        }
+        last = to;
+    };
+    
+    // Sparse levels below 0 come first, then the bitmap levels in order,
+    // then the sparse levels above them
+    auto it = sparse.begin();
+    for (; it != sparse.end() && it->first < 0; ++it) {
+        for (size_t id : it->second) {
+            append(id, id);
+        }
+    }
+    for (int i = 0; i < WORDS; i++) {
+        INSTRUMENT(scannedEntries++;)
+        uint64_t bits = bitmap[i];
+        while (bits != 0) {
+            int level = i * WORD_BITS + __builtin_ctzll(bits);
+            append(head[level], tail[level]);
+            head[level] = NONE;
+            tail[level] = NONE;
+            bits &= bits - 1;
+        }
+        bitmap[i] = 0;
+    }
+    for (; it != sparse.end(); ++it) {
+        for (size_t id : it->second) {
+            append(id, id);
+        }
+    }
+    sparse.clear();
+    
+    if (first == NONE) {
+        return;
+    }
+    next[last] = NONE;
+    head[priority] = first;
+    tail[priority] = last;
+    bitmap[priority / WORD_BITS] |= uint64_t(1) << (priority % WORD_BITS);
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#ifndef PRIORITY_RUN_QUEUE_H
+#define PRIORITY_RUN_QUEUE_H
+
+#include <vector>
+#include <map>
+#include <deque>
+#include <cstdint>
+#include <cstddef>
+#include "scratch_arena.h"
+
+using namespace std;
+
+/**
+ * @class PriorityRunQueue
+ * @brief Multi-level run queue in the style of the Linux O(1) scheduler
+ * 
+ * Keeps one FIFO list per priority level and a bitmap of the non-empty
+ * levels, so the highest-priority (lowest value) ID is found with a
+ * find-first-set over a few words. Lists are intrusive over dense IDs, so
+ * pushing, popping and peeking all take constant time. The links live in
+ * the thread's ScratchArena. Priorities outside [0, LEVELS) fall back to a
+ * sparse map of FIFO lists on the ordinary heap.
+ */
+class PriorityRunQueue {
+public:
+    static const int LEVELS = 256;  // Priorities [0, LEVELS) use the bitmap
+
+private:
+    static const int WORD_BITS = 64;
+    static const int WORDS = LEVELS / WORD_BITS;
+    static const size_t NONE = static_cast<size_t>(-1);
+
+    uint64_t bitmap[WORDS];          // Bit set for every non-empty level
+    size_t head[LEVELS];             // First ID of each level, or NONE
+    size_t tail[LEVELS];             // Last ID of each level, or NONE
+    ScratchVector<size_t> next;      // Intrusive links between IDs of a level
+    map<int, deque<size_t>> sparse;  // Lists for priorities outside the bitmap
+    size_t count;                    // Number of queued IDs
+
+    static bool inRange(int priority);
+    int firstLevel() const;
+    int bestPriority() const;
+
+public:
+    /**
+     * @brief Constructor for PriorityRunQueue
+     */
+    PriorityRunQueue();
+
+    /**
+     * @brief Empties the queue and sizes it for IDs below capacity
+     * @param capacity One past the largest ID that will be pushed
+     * 
+     * Takes fresh storage from the arena, so call it after the arena's reset.
+     */
+    void reset(size_t capacity);
+
+    /**
+     * @brief Sizes the queue for IDs below capacity, keeping queued IDs
+     * @param capacity New upper bound on IDs; smaller values are ignored
+     */
+    void grow(size_t capacity);
+
+    bool empty() const;
+    size_t size() const;
+
+    /**
+     * @brief Appends an ID behind all others of the same priority
+     * @param id ID below the capacity given to reset()
+     * @param priority Priority level (lower value means higher priority)
+     */
+    void pushBack(size_t id, int priority);
+
+    /**
+     * @brief Puts an ID ahead of all others of the same priority
+     * @param id ID below the capacity given to reset()
+     * @param priority Priority level (lower value means higher priority)
+     * 
+     * Used for a preempted process, which keeps its place in line.
+     */
+    void pushFront(size_t id, int priority);
+
+    /**
+     * @brief Gets the first ID of the highest-priority non-empty level
+     * @return ID that would be popped next
+     */
+    size_t top() const;
+
+    /**
+     * @brief Gets the priority of the level top() takes its ID from
+     * @return Priority level of the next ID
+     */
+    int topPriority() const;
+
+    /**
+     * @brief Removes and returns the first ID of the highest-priority non-empty level
+     * @return Removed ID
+     */
+    size_t pop();
+
+    /**
+     * @brief Moves every queued ID to one level, keeping the order pop() would take them in
+     * @param priority Priority level in [0, LEVELS) that receives them
+     * 
+     * The lists of the non-empty bitmap levels are spliced end to end, so
+     * this takes O(LEVELS) time however many IDs are queued; IDs at
+     * priorities outside the bitmap are linked in one at a time.
+     */
+    void liftAll(int priority);
+};
+
+#endif // PRIORITY_RUN_QUEUE_H
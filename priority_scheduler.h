@@ -1,44 +1,35 @@
 #ifndef PRIORITY_SCHEDULER_H
 #define PRIORITY_SCHEDULER_H
 
-#include "scheduler.h"
+#include "policy_scheduler.h"
 
 /**
- * @class PriorityScheduler
- * @brief Priority scheduling algorithm implementation
- * 
- * Processes are executed based on their priority, with lower priority values indicating higher priority.
- * This implementation supports both preemptive and non-preemptive modes.
+ * @struct HighestPriority
+ * @brief Key policy for Priority scheduling: lower priority value first
  */
-class PriorityScheduler : public Scheduler {
-private:
-    bool preemptive; // Flag to determine if scheduler is preemptive
-
-public:
-    /**
-     * @brief Constructor for PriorityScheduler
-     * @param processes List of processes to schedule
-     * @param preemptive Flag to determine if scheduler is preemptive
-     */
-    PriorityScheduler(const vector<Process>& processes, bool preemptive = false);
-    
-    /**
-     * @brief Runs the Priority scheduling algorithm
-     * @return SchedulerResult containing all metrics
-     */
-    SchedulerResult run() override;
+struct HighestPriority {
+    static const bool FIXED_KEY = true;           // Priorities are part of the workload
+    static const bool RUNNING_KEY_GROWS = false;
     
-    /**
-     * @brief Gets the name of the scheduling algorithm
-     * @return String name of the algorithm
-     */
-    string getName() const override;
+    static int key(uint32_t pid, const JobState& /*jobs*/, const ProcessTable& table) {
+        return table.priority[pid];
+    }
     
-    /**
-     * @brief Gets the description of the scheduling algorithm
-     * @return String description of the algorithm
-     */
-    string getDescription() const override;
+    static string name(bool preemptive);
+    static string description(bool preemptive);
 };
 
+/**
+ * @brief Non-preemptive Priority scheduling: the highest-priority waiting process runs to completion
+ */
+typedef PolicyScheduler<HighestPriority, NonPreemptive> PriorityScheduler;
+
+/**
+ * @brief Preemptive Priority scheduling: an arrival of strictly higher priority takes the CPU
+ */
+typedef PolicyScheduler<HighestPriority, Preemptive> PreemptivePriorityScheduler;
+
+extern template class PolicyScheduler<HighestPriority, NonPreemptive>;
+extern template class PolicyScheduler<HighestPriority, Preemptive>;
+
 #endif // PRIORITY_SCHEDULER_H
\ No newline at end of file
@@ -1,5 +1,75 @@
 #include "process_loader.h"
+#include "csv_reader.h"
+#include "workload_file.h"
+#include <fstream>
+#include <utility>
 
-// Since all methods in ProcessLoader are static and defined in the header file,
-// there's no need for additional implementation here.
-// This file exists to satisfy the build process.
\ No newline at end of file
+vector<Process> ProcessLoader::loadFromCSV(const string& filePath) {
+    CsvProcessReader reader(filePath);
+    
+    // One process per line at most, so a newline count bounds the capacity
+    vector<Process> processes;
+    processes.reserve(reader.countLines() + 1);
+    
+    Process process("", 0, 0);
+    while (reader.next(process)) {
+        processes.push_back(move(process));
+    }
+    
+    return processes;
+}
+
+ProcessTable ProcessLoader::loadTable(const string& filePath) {
+    INSTRUMENT(auto started = chrono::steady_clock::now();)
+    ProcessTable table = WorkloadFile::isWorkloadFile(filePath) 
+                         ? WorkloadFile(filePath).toTable() 
+                         : ProcessTable(loadFromCSV(filePath));
+    INSTRUMENT(table.loadSeconds = secondsSince(started) - table.sortSeconds;)
+    return table;
+}
+
+void ProcessLoader::saveToCSV(const ProcessTable& table, const string& filePath) {
+    static const size_t FLUSH_BYTES = 1 << 20;
+    
+    ofstream out(filePath, ios::binary | ios::trunc);
+    if (!out.is_open()) {
+        throw runtime_error("Failed to open file: " + filePath);
+    }
+    
+    // Format into a large buffer and write it out in blocks
+    string buffer = "ID,ArrivalTime,BurstTime,Priority,Deadline\n";
+    buffer.reserve(FLUSH_BYTES + 256);
+    for (size_t pid = 0; pid < table.size(); pid++) {
+        buffer += table.name(static_cast<uint32_t>(pid));
+        buffer += ',';
+        buffer += to_string(table.arrival[pid]);
+        buffer += ',';
+        buffer += to_string(table.burst[pid]);
+        buffer += ',';
+        buffer += to_string(table.priority[pid]);
+        buffer += ',';
+        buffer += to_string(table.deadline[pid]);
+        buffer += '\n';
+        if (buffer.size() >= FLUSH_BYTES) {
+            out.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+    out.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+    
+    if (!out) {
+        throw runtime_error("Failed to write file: " + filePath);
+    }
+}
+
+void ProcessLoader::saveToBinary(const ProcessTable& table, const string& filePath) {
+    WorkloadFile::write(table, filePath);
+}
+
+void ProcessLoader::convert(const string& inputPath, const string& outputPath) {
+    if (WorkloadFile::isWorkloadFile(inputPath)) {
+        saveToCSV(WorkloadFile(inputPath).toTable(), outputPath);
+    } else {
+        saveToBinary(ProcessTable(loadFromCSV(inputPath)), outputPath);
+    }
+}
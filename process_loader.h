@@ -3,9 +3,9 @@
 
 #include <string>
 #include <vector>
-#include <fstream>
 #include <stdexcept>
 #include "process.h"
+#include "process_table.h"
 
 using namespace std;
 
@@ -20,54 +20,47 @@ public:
      * @param filePath Path to the CSV file
      * @return Vector of Process objects
      * 
-     * CSV format: ID,ArrivalTime,BurstTime,Priority
+     * CSV format: ID,ArrivalTime,BurstTime,Priority[,Deadline]
      * Example: P1,0,5,2
+     * 
+     * The first line is a header and is skipped, as are blank lines. The file
+     * is memory-mapped and parsed in place. Throws runtime_error naming the
+     * file and line number of the first malformed line.
      */
-    static vector<Process> loadFromCSV(const string& filePath) {
-        vector<Process> processes;
-        ifstream file(filePath);
-        
-        if (!file.is_open()) {
-            throw runtime_error("Failed to open file: " + filePath);
-        }
-        
-        string line;
-        // Skip header if present
-        getline(file, line);
-        
-        while (getline(file, line)) {
-            if (line.empty()) continue;
-            
-            // Parse CSV line
-            size_t pos = 0;
-            vector<string> tokens;
-            string delimiter = ",";
-            string token;
-            string tempLine = line;
-            
-            while ((pos = tempLine.find(delimiter)) != string::npos) {
-                token = tempLine.substr(0, pos);
-                tokens.push_back(token);
-                tempLine.erase(0, pos + delimiter.length());
-            }
-            tokens.push_back(tempLine); // Add the last token
-            
-            if (tokens.size() < 4) {
-                continue; // Skip invalid lines
-            }
-            
-            // Create Process object
-            string id = tokens[0];
-            int arrivalTime = stoi(tokens[1]);
-            int burstTime = stoi(tokens[2]);
-            int priority = stoi(tokens[3]);
-            
-            processes.push_back(Process(id, arrivalTime, burstTime, priority));
-        }
-        
-        file.close();
-        return processes;
-    }
+    static vector<Process> loadFromCSV(const string& filePath);
+    
+    /**
+     * @brief Load a process table from a CSV or binary workload file
+     * @param filePath Path to the file
+     * @return ProcessTable with rows sorted by arrival time
+     * 
+     * Binary workload files (see WorkloadFile) are recognized by their magic
+     * and used straight from the mapping; anything else is parsed as CSV.
+     */
+    static ProcessTable loadTable(const string& filePath);
+    
+    /**
+     * @brief Write a process table as CSV
+     * @param table Table to write
+     * @param filePath Path of the file to create
+     * 
+     * Writes the header line and all five columns, in PID order.
+     */
+    static void saveToCSV(const ProcessTable& table, const string& filePath);
+    
+    /**
+     * @brief Write a process table in the binary workload format
+     * @param table Table to write
+     * @param filePath Path of the file to create
+     */
+    static void saveToBinary(const ProcessTable& table, const string& filePath);
+    
+    /**
+     * @brief Convert a workload between CSV and the binary format
+     * @param inputPath CSV or binary workload file
+     * @param outputPath File to create; binary if the input is CSV and vice versa
+     */
+    static void convert(const string& inputPath, const string& outputPath);
     
     /**
      * @brief Get list of available test case files in the test_cases directory
@@ -0,0 +1,148 @@
+#include "process_table.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    // Rejects a workload whose simulated time would overflow
+    void checkWorkEnd(const vector<int>& arrival, const vector<int>& burst) {
+        long long workEnd = 0;
+        for (size_t pid = 0; pid < arrival.size(); pid++) {
+            workEnd = extendWorkEnd(workEnd, arrival[pid], burst[pid]);
+            if (workEnd > MAX_WORK_END) {
+                throw invalid_argument("Workload keeps a CPU busy past time " + to_string(MAX_WORK_END) +
+                                       " (at process " + to_string(pid + 1) + " in arrival order)");
+            }
+        }
+    }
+}
+
+ProcessTable::ProcessTable() 
+    : loadSeconds(0), sortSeconds(0), nameTable(make_shared<vector<string>>()) {}
+
+ProcessTable::ProcessTable(const vector<Process>& processes)
+    : loadSeconds(0), sortSeconds(0), nameTable(make_shared<vector<string>>()) {
+    INSTRUMENT(auto started = chrono::steady_clock::now();)
+    
+    // Sort row order by arrival time; the stable sort keeps input order
+    // among simultaneous arrivals
+    vector<size_t> order(processes.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    stable_sort(order.begin(), order.end(), 
+                [&processes](size_t a, size_t b) {
+                    return processes[a].getArrivalTime() < processes[b].getArrivalTime();
+                });
+    INSTRUMENT(sortSeconds = secondsSince(started);)
+    
+    size_t count = processes.size();
+    arrival.reserve(count);
+    burst.reserve(count);
+    priority.reserve(count);
+    deadline.reserve(count);
+    sequence.reserve(count);
+    nameTable->reserve(count);
+    
+    for (size_t index : order) {
+        const Process& process = processes[index];
+        arrival.push_back(process.getArrivalTime());
+        burst.push_back(process.getBurstTime());
+        priority.push_back(process.getPriority());
+        deadline.push_back(process.getDeadline());
+        sequence.push_back(sequence.size());
+        nameTable->push_back(process.getId());
+    }
+    
+    checkWorkEnd(arrival, burst);
+}
+
+ProcessTable::ProcessTable(vector<int> arrival, vector<int> burst, vector<int> priority, 
+                           vector<int> deadline, vector<string> names)
+    : arrival(move(arrival)), burst(move(burst)), priority(move(priority)), 
+      deadline(move(deadline)), loadSeconds(0), sortSeconds(0), 
+      nameTable(make_shared<vector<string>>(move(names))) {
+    size_t count = this->arrival.size();
+    if (this->burst.size() != count || this->priority.size() != count || 
+        this->deadline.size() != count || nameTable->size() != count) {
+        throw invalid_argument("ProcessTable columns differ in length");
+    }
+    INSTRUMENT(auto started = chrono::steady_clock::now();)
+    if (!is_sorted(this->arrival.begin(), this->arrival.end())) {
+        throw invalid_argument("ProcessTable rows are not sorted by arrival time");
+    }
+    INSTRUMENT(sortSeconds = secondsSince(started);)
+    checkWorkEnd(this->arrival, this->burst);
+    
+    sequence.resize(count);
+    for (size_t pid = 0; pid < count; pid++) {
+        sequence[pid] = pid;
+    }
+}
+
+size_t ProcessTable::size() const {
+    return arrival.size();
+}
+
+bool ProcessTable::empty() const {
+    return arrival.empty();
+}
+
+void ProcessTable::clear() {
+    arrival.clear();
+    burst.clear();
+    priority.clear();
+    deadline.clear();
+    sequence.clear();
+    
+    // Earlier results may still share the old names
+    nameTable = make_shared<vector<string>>();
+}
+
+void ProcessTable::setRow(uint32_t pid, const Process& process, uint64_t order) {
+    if (pid == size()) {
+        arrival.push_back(0);
+        burst.push_back(0);
+        priority.push_back(0);
+        deadline.push_back(0);
+        sequence.push_back(0);
+        nameTable->push_back(string());
+    }
+    
+    arrival[pid] = process.getArrivalTime();
+    burst[pid] = process.getBurstTime();
+    priority[pid] = process.getPriority();
+    deadline[pid] = process.getDeadline();
+    sequence[pid] = order;
+    (*nameTable)[pid] = process.getId();
+}
+
+string ProcessTable::takeName(uint32_t pid) {
+    return move((*nameTable)[pid]);
+}
+
+const string& ProcessTable::name(uint32_t pid) const {
+    return (*nameTable)[pid];
+}
+
+shared_ptr<const vector<string>> ProcessTable::names() const {
+    return nameTable;
+}
+
+void JobState::reset(const ProcessTable& table) {
+    renew(remaining);
+    remaining.assign(table.burst.begin(), table.burst.end());
+    completion.assign(table.size(), 0);
+    response.assign(table.size(), -1);
+}
+
+void JobState::resetRow(uint32_t pid, int burst) {
+    if (pid == remaining.size()) {
+        remaining.push_back(0);
+        completion.push_back(0);
+        response.push_back(0);
+    }
+    remaining[pid] = burst;
+    completion[pid] = 0;
+    response[pid] = -1;
+}
@@ -0,0 +1,181 @@
+#ifndef PROCESS_TABLE_H
+#define PROCESS_TABLE_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+#include "process.h"
+#include "scheduler_stats.h"
+#include "scratch_arena.h"
+
+using namespace std;
+
+/**
+ * @brief PID used where no process applies, e.g. an idle CPU or an empty ready queue
+ */
+const uint32_t NO_PID = UINT32_MAX;
+
+/**
+ * @brief Latest time a workload may keep a CPU busy until
+ * 
+ * Simulated time is an int, and its largest value stands for "no more
+ * arrivals", so every run must end before it.
+ */
+const long long MAX_WORK_END = numeric_limits<int>::max() - 1LL;
+
+/**
+ * @brief Adds a process to the time at which a single CPU would finish the work so far
+ * @param workEnd Finish time of the earlier processes, 0 for none
+ * @param arrival Arrival time of the process, not before any earlier one
+ * @param burst Burst time of the process
+ * @return Finish time including the process
+ * 
+ * Every scheduler keeps a CPU busy while any process waits, so no run of
+ * the workload, on any number of CPUs, ends later than this.
+ */
+inline long long extendWorkEnd(long long workEnd, int arrival, int burst) {
+    return max<long long>(workEnd, arrival) + burst;
+}
+
+/**
+ * @struct ProcessTable
+ * @brief Columnar (struct-of-arrays) process table used by the simulation
+ * 
+ * Each process is a row identified by a dense uint32_t PID. Rows are sorted
+ * by arrival time, stably, and the sequence column records that order; it
+ * is the tie-break every algorithm uses. Each attribute lives in its own
+ * column, so a hot loop only touches the columns it needs. Process names
+ * are interned once in a shared side table and never copied during a run.
+ * 
+ * The table is the workload only: it is sorted once when built, and
+ * schedulers read it in place, shared between them, while each run keeps
+ * what it changes in its own JobState.
+ * 
+ * Streaming runs use a table as a pool of live rows instead: a row is
+ * reused by setRow() once its process completes, and only the sequence
+ * column still reflects arrival order.
+ */
+struct ProcessTable {
+    // Workload columns, fixed after construction
+    vector<int> arrival;        // Time at which the process arrives
+    vector<int> burst;          // Total CPU time required
+    vector<int> priority;       // Priority level (lower value means higher priority)
+    vector<int> deadline;       // Deadline for EDF scheduling
+    vector<uint64_t> sequence;  // Arrival order; ties go to the lower value
+    
+    // Build timings, only measured in instrumented builds (see SchedulerStats)
+    double loadSeconds;         // Time spent reading the workload into the table
+    double sortSeconds;         // Time spent ordering rows by arrival
+    
+    /**
+     * @brief Constructor for an empty ProcessTable
+     */
+    ProcessTable();
+    
+    /**
+     * @brief Builds the table from a list of processes
+     * @param processes Processes in any order; rows are stably sorted by arrival
+     * 
+     * Throws invalid_argument if the work would run past MAX_WORK_END.
+     */
+    explicit ProcessTable(const vector<Process>& processes);
+    
+    /**
+     * @brief Builds the table from ready-made columns
+     * @param arrival Arrival times, already sorted in ascending order
+     * @param burst Burst times
+     * @param priority Priority levels
+     * @param deadline Deadlines
+     * @param names Process names
+     * 
+     * All columns must have the same length. Throws invalid_argument otherwise,
+     * if the rows are not sorted by arrival or if the work would run past
+     * MAX_WORK_END.
+     */
+    ProcessTable(vector<int> arrival, vector<int> burst, vector<int> priority, 
+                 vector<int> deadline, vector<string> names);
+    
+    /**
+     * @brief Gets the number of processes
+     * @return Row count
+     */
+    size_t size() const;
+    
+    /**
+     * @brief Checks whether the table has no processes
+     * @return True if there are no rows
+     */
+    bool empty() const;
+    
+    /**
+     * @brief Removes every row
+     */
+    void clear();
+    
+    /**
+     * @brief Fills a row with a fresh process, appending it if pid == size()
+     * @param pid Row to overwrite, or size() to append
+     * @param process Process to store
+     * @param order Position of the process in arrival order
+     */
+    void setRow(uint32_t pid, const Process& process, uint64_t order);
+    
+    /**
+     * @brief Moves the name out of a row that is about to be reused
+     * @param pid Row whose name is taken
+     * @return The name
+     */
+    string takeName(uint32_t pid);
+    
+    /**
+     * @brief Gets the name of a process
+     * @param pid Process row
+     * @return Interned name
+     */
+    const string& name(uint32_t pid) const;
+    
+    /**
+     * @brief Gets the shared name table, indexed by PID
+     * @return Name table
+     */
+    shared_ptr<const vector<string>> names() const;
+
+private:
+    shared_ptr<vector<string>> nameTable;  // Interned process names, indexed by PID
+};
+
+/**
+ * @struct JobState
+ * @brief What a run changes about each process of a ProcessTable, indexed by PID
+ * 
+ * Nothing else changes during a run, so any number of schedulers can
+ * simulate one table at once, each with its own JobState. Remaining times
+ * are working memory in the thread's ScratchArena; completion and
+ * response times become columns of the result.
+ */
+struct JobState {
+    ScratchVector<int> remaining;   // Remaining CPU time needed
+    vector<int> completion;         // Time at which the process completed
+    vector<int> response;           // First dispatch time - arrival time, or -1 before it
+    
+    /**
+     * @brief Puts every process of a table back in its state before a run
+     * @param table Table the run simulates
+     * 
+     * Takes fresh scratch storage, so call it after the arena's reset.
+     */
+    void reset(const ProcessTable& table);
+    
+    /**
+     * @brief Puts one process in its state before a run, appending it if pid == size
+     * @param pid Process to reset
+     * @param burst Its total CPU time
+     */
+    void resetRow(uint32_t pid, int burst);
+};
+
+#endif // PROCESS_TABLE_H
@@ -0,0 +1,289 @@
+#include "replication_runner.h"
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    const char* const METRIC_NAMES[METRIC_COUNT] = {
+        "avg_turnaround", "avg_waiting", "avg_response", "throughput", "cpu_utilization", "steals"
+    };
+    const char* const METRIC_LABELS[METRIC_COUNT] = {
+        "Turnaround", "Waiting", "Response", "Throughput", "CPU %", "Steals"
+    };
+    
+    // 97.5% quantile of Student's t with 1 to 30 degrees of freedom
+    const double T_QUANTILES[30] = {
+        12.7062, 4.3027, 3.1824, 2.7764, 2.5706, 2.4469, 2.3646, 2.3060, 2.2622, 2.2281,
+        2.2010, 2.1788, 2.1604, 2.1448, 2.1314, 2.1199, 2.1098, 2.1009, 2.0930, 2.0860,
+        2.0796, 2.0739, 2.0687, 2.0639, 2.0595, 2.0555, 2.0518, 2.0484, 2.0452, 2.0423
+    };
+    
+    double tQuantile(size_t degrees) {
+        if (degrees <= 30) {
+            return T_QUANTILES[degrees - 1];
+        }
+        // Cornish-Fisher expansion around the normal quantile; well within
+        // table precision from 30 degrees of freedom on
+        const double z = 1.959964;
+        double v = static_cast<double>(degrees);
+        double z2 = z * z;
+        return z + z * (z2 + 1) / (4 * v)
+                 + z * ((5 * z2 + 16) * z2 + 3) / (96 * v * v)
+                 + z * (((3 * z2 + 19) * z2 + 17) * z2 - 15) / (384 * v * v * v);
+    }
+    
+    // Welford's running mean and sum of squared deviations
+    struct RunningMoments {
+        size_t count = 0;
+        double mean = 0;
+        double squares = 0;
+        
+        void add(double value) {
+            count++;
+            double delta = value - mean;
+            mean += delta / count;
+            squares += delta * (value - mean);
+        }
+        
+        ConfidenceInterval interval() const {
+            if (count < 2) {
+                return {mean, numeric_limits<double>::infinity()};
+            }
+            double variance = squares / (count - 1);
+            return {mean, tQuantile(count - 1) * sqrt(variance / count)};
+        }
+    };
+    
+    // Metrics of every algorithm on one replication's workload
+    struct Replication {
+        vector<double> values;     // METRIC_COUNT values per algorithm
+        vector<string> names;      // Scheduler names, empty for skipped algorithms
+        exception_ptr error;       // Set if the replication failed
+    };
+    
+    void extractMetrics(const SchedulerResult& result, double* values) {
+        values[TURNAROUND_METRIC] = result.avgTurnaroundTime;
+        values[WAITING_METRIC] = result.avgWaitingTime;
+        values[RESPONSE_METRIC] = result.avgResponseTime;
+        values[THROUGHPUT_METRIC] = result.throughput;
+        values[UTILIZATION_METRIC] = result.cpuUtilization;
+        values[STEALS_METRIC] = static_cast<double>(result.steals);
+    }
+}
+
+ReplicationRunner::ReplicationRunner(const WorkloadSpec& spec, size_t threads)
+    : spec(spec), cpus(1), queueMode(PER_CPU_QUEUES), minReplications(30), maxReplications(30),
+      precision(0), pool(threads) {
+    spec.validate();
+    if (spec.jobs < 1) {
+        throw invalid_argument("A replication needs at least one process");
+    }
+}
+
+void ReplicationRunner::add(SchedulerFactory factory) {
+    algorithms.push_back(move(factory));
+}
+
+void ReplicationRunner::addDefaultAlgorithms(int timeQuantum) {
+    for (auto& factory : defaultAlgorithms(timeQuantum)) {
+        add(move(factory));
+    }
+}
+
+void ReplicationRunner::setCpus(size_t count, QueueMode mode) {
+    if (count < 1) {
+        throw invalid_argument("A replication needs at least one CPU");
+    }
+    cpus = count;
+    queueMode = mode;
+}
+
+void ReplicationRunner::setReplications(size_t minimum, size_t maximum) {
+    if (minimum < 2 || maximum < minimum) {
+        throw invalid_argument("Replications must satisfy 2 <= minimum <= maximum");
+    }
+    minReplications = minimum;
+    maxReplications = maximum;
+}
+
+void ReplicationRunner::setPrecision(double relativeHalfWidth) {
+    if (!(relativeHalfWidth >= 0)) {
+        throw invalid_argument("Precision must not be negative");
+    }
+    precision = relativeHalfWidth;
+}
+
+vector<ReplicationEstimate> ReplicationRunner::run() {
+    size_t count = algorithms.size();
+    vector<RunningMoments> moments(count * METRIC_COUNT);
+    vector<ReplicationEstimate> estimates(count);
+    for (auto& estimate : estimates) {
+        estimate.replications = 0;
+        estimate.converged = false;
+    }
+    
+    // Read by workers before each run, so a stopped algorithm is skipped
+    // even by replications already in flight
+    unique_ptr<atomic<bool>[]> stopped(new atomic<bool>[count]);
+    for (size_t a = 0; a < count; a++) {
+        stopped[a] = false;
+    }
+    atomic<bool> abandoned(false);
+    size_t running = count;
+    
+    mutex lock;                          // Guards finished
+    condition_variable replicationDone;  // Signalled when a replication is added to finished
+    map<size_t, Replication> finished;   // Replications done but not yet folded, by index
+    
+    size_t window = 2 * pool.size();
+    size_t submitted = 0;
+    size_t folded = 0;
+    
+    while (folded < maxReplications && running > 0) {
+        while (submitted < maxReplications && submitted - folded < window) {
+            size_t index = submitted++;
+            pool.submit([this, index, count, &stopped, &abandoned, &lock, &replicationDone, &finished] {
+                if (abandoned) {
+                    return;
+                }
+                Replication replication;
+                replication.values.resize(count * METRIC_COUNT);
+                replication.names.resize(count);
+                try {
+                    WorkloadSpec replica = spec;
+                    replica.seed = WorkloadGenerator::streamSeed(spec.seed, index);
+                    ProcessTable workload = WorkloadGenerator::generateTable(replica);
+                    
+                    for (size_t a = 0; a < count && !abandoned; a++) {
+                        if (stopped[a]) {
+                            continue;
+                        }
+                        unique_ptr<Scheduler> scheduler = algorithms[a](workload);
+                        scheduler->setCpus(cpus, queueMode);
+                        replication.names[a] = scheduler->getName();
+                        extractMetrics(scheduler->run(), &replication.values[a * METRIC_COUNT]);
+                    }
+                } catch (...) {
+                    replication.error = current_exception();
+                }
+                
+                // Notify under the lock: once it is released the caller may
+                // finish and return
+                lock_guard<mutex> guard(lock);
+                finished[index] = move(replication);
+                replicationDone.notify_one();
+            });
+        }
+        
+        Replication next;
+        {
+            unique_lock<mutex> guard(lock);
+            replicationDone.wait(guard, [&finished, folded] {
+                return !finished.empty() && finished.begin()->first == folded;
+            });
+            next = move(finished.begin()->second);
+            finished.erase(finished.begin());
+        }
+        if (next.error) {
+            abandoned = true;
+            pool.wait();
+            rethrow_exception(next.error);
+        }
+        
+        // An algorithm still running here has not stopped when this
+        // replication started, so it was simulated
+        for (size_t a = 0; a < count; a++) {
+            if (stopped[a]) {
+                continue;
+            }
+            ReplicationEstimate& estimate = estimates[a];
+            estimate.algorithmName = next.names[a];
+            estimate.replications++;
+            
+            bool settled = precision > 0 && estimate.replications >= minReplications;
+            for (int m = 0; m < METRIC_COUNT; m++) {
+                RunningMoments& metric = moments[a * METRIC_COUNT + m];
+                metric.add(next.values[a * METRIC_COUNT + m]);
+                estimate.metrics[m] = metric.interval();
+                settled = settled && estimate.metrics[m].halfWidth <= precision * fabs(estimate.metrics[m].mean);
+            }
+            if (settled) {
+                estimate.converged = true;
+                stopped[a] = true;
+                running--;
+            }
+        }
+        folded++;
+    }
+    
+    // Replications started past the stopping point are not needed
+    abandoned = true;
+    pool.wait();
+    return estimates;
+}
+
+const char* ReplicationRunner::metricName(ReplicatedMetric metric) {
+    return METRIC_NAMES[metric];
+}
+
+void ReplicationRunner::writeTable(ostream& out, const vector<ReplicationEstimate>& estimates) {
+    out << left << setw(38) << "Algorithm" << right << setw(6) << "Runs" << "  "
+        << left << setw(12) << "Metric" << right << setw(14) << "Mean" << setw(14) << "+/- 95%" << "\n";
+    
+    for (const auto& estimate : estimates) {
+        for (int m = 0; m < METRIC_COUNT; m++) {
+            string runs = to_string(estimate.replications) + (estimate.converged ? "*" : " ");
+            out << left << setw(38) << (m == 0 ? estimate.algorithmName : "") << right
+                << setw(6) << (m == 0 ? runs : "") << "  "
+                << left << setw(12) << METRIC_LABELS[m] << right << fixed << setprecision(4)
+                << setw(14) << estimate.metrics[m].mean << setw(14) << estimate.metrics[m].halfWidth << "\n";
+        }
+    }
+    out << "* stopped early at the precision target\n";
+}
+
+void ReplicationRunner::writeCsv(ostream& out, const vector<ReplicationEstimate>& estimates) {
+    out << "algorithm,replications,converged,metric,mean,half_width,ci_low,ci_high\n";
+    out << setprecision(10);
+    for (const auto& estimate : estimates) {
+        for (int m = 0; m < METRIC_COUNT; m++) {
+            const ConfidenceInterval& interval = estimate.metrics[m];
+            out << estimate.algorithmName << "," << estimate.replications << ","
+                << (estimate.converged ? "1" : "0") << "," << METRIC_NAMES[m] << ","
+                << interval.mean << "," << interval.halfWidth << ","
+                << interval.mean - interval.halfWidth << "," << interval.mean + interval.halfWidth << "\n";
+        }
+    }
+}
+
+void ReplicationRunner::writeJson(ostream& out, const vector<ReplicationEstimate>& estimates) {
+    out << "[" << setprecision(10);
+    for (size_t i = 0; i < estimates.size(); i++) {
+        const ReplicationEstimate& estimate = estimates[i];
+        out << (i == 0 ? "\n  {" : ",\n  {")
+            << "\"algorithm\": \"" << estimate.algorithmName << "\""
+            << ", \"replications\": " << estimate.replications
+            << ", \"converged\": " << (estimate.converged ? "true" : "false") << ", \"metrics\": {";
+        for (int m = 0; m < METRIC_COUNT; m++) {
+            const ConfidenceInterval& interval = estimate.metrics[m];
+            out << (m == 0 ? "\"" : ", \"") << METRIC_NAMES[m] << "\": {\"mean\": " << interval.mean
+                << ", \"half_width\": ";
+            if (isfinite(interval.halfWidth)) {
+                out << interval.halfWidth;
+            } else {
+                out << "null";
+            }
+            out << "}";
+        }
+        out << "}}";
+    }
+    out << (estimates.empty() ? "]\n" : "\n]\n");
+}
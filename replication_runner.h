@@ -0,0 +1,157 @@
+#ifndef REPLICATION_RUNNER_H
+#define REPLICATION_RUNNER_H
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include "scheduler.h"
+#include "comparison_runner.h"
+#include "workload_generator.h"
+#include "thread_pool.h"
+
+using namespace std;
+
+/**
+ * @enum ReplicatedMetric
+ * @brief Scalar fields of SchedulerResult that replications estimate
+ */
+enum ReplicatedMetric {
+    TURNAROUND_METRIC,    // avgTurnaroundTime
+    WAITING_METRIC,       // avgWaitingTime
+    RESPONSE_METRIC,      // avgResponseTime
+    THROUGHPUT_METRIC,    // throughput
+    UTILIZATION_METRIC,   // cpuUtilization
+    STEALS_METRIC,        // steals
+    METRIC_COUNT
+};
+
+/**
+ * @struct ConfidenceInterval
+ * @brief Sample mean of a metric with the half-width of its 95% confidence interval
+ */
+struct ConfidenceInterval {
+    double mean;       // Mean over the replications
+    double halfWidth;  // The interval is mean +/- halfWidth; infinite below two replications
+};
+
+/**
+ * @struct ReplicationEstimate
+ * @brief Estimates of every metric of one algorithm
+ */
+struct ReplicationEstimate {
+    string algorithmName;                      // Scheduler::getName() of the algorithm
+    size_t replications;                       // Replications the estimates are based on
+    bool converged;                            // Stopped early because every interval met the target
+    ConfidenceInterval metrics[METRIC_COUNT];  // Indexed by ReplicatedMetric
+};
+
+/**
+ * @class ReplicationRunner
+ * @brief Estimates each algorithm's metrics over many independent generated workloads
+ * 
+ * Replication i generates a workload from the spec with its own seed,
+ * WorkloadGenerator::streamSeed(spec.seed, i), and runs every algorithm on
+ * it, so the algorithms are compared on the same workloads. Replications run
+ * on the pool and are folded into running means and variances in index
+ * order, so the estimates depend only on the spec and not on the thread
+ * count. Intervals use Student's t distribution.
+ * 
+ * With a precision target, an algorithm stops once every one of its
+ * intervals is within the target relative to its mean, after at least
+ * minReplications; later replications leave it out, and the run ends when
+ * every algorithm has stopped or maxReplications is reached.
+ */
+class ReplicationRunner {
+private:
+    WorkloadSpec spec;                    // Workload each replication generates
+    vector<SchedulerFactory> algorithms;  // Algorithms to estimate, in output order
+    size_t cpus;                          // Simulated CPUs in every run
+    QueueMode queueMode;                  // How those CPUs share ready processes
+    size_t minReplications;               // Replications before early stopping is considered
+    size_t maxReplications;               // Replications when no target is met first
+    double precision;                     // Target half-width relative to the mean, 0 for none
+    ThreadPool pool;                      // Workers that generate and simulate replications
+
+public:
+    /**
+     * @brief Constructor for ReplicationRunner
+     * @param spec Workload parameters; throws invalid_argument if they are invalid
+     * @param threads Number of worker threads, or 0 for one per hardware thread
+     * 
+     * Defaults to 30 replications, no precision target and one CPU.
+     */
+    explicit ReplicationRunner(const WorkloadSpec& spec, size_t threads = 0);
+    
+    /**
+     * @brief Adds an algorithm to estimate
+     * @param factory Builds the algorithm's scheduler for a workload
+     */
+    void add(SchedulerFactory factory);
+    
+    /**
+     * @brief Adds the ten algorithms of the interactive menu
+     * @param timeQuantum Time quantum for Round Robin, and the top-level quantum of MLFQ
+     */
+    void addDefaultAlgorithms(int timeQuantum = 2);
+    
+    /**
+     * @brief Sets the simulated CPUs every run uses
+     * @param count Number of CPUs, at least 1
+     * @param mode Whether the CPUs share one ready queue or each have their own
+     */
+    void setCpus(size_t count, QueueMode mode);
+    
+    /**
+     * @brief Sets how many replications to run
+     * @param minimum Replications every algorithm gets before it may stop early, at least 2
+     * @param maximum Replications at most, at least minimum
+     */
+    void setReplications(size_t minimum, size_t maximum);
+    
+    /**
+     * @brief Sets the precision at which an algorithm stops early
+     * @param relativeHalfWidth Largest half-width as a fraction of |mean|, or 0 to always run maximum
+     */
+    void setPrecision(double relativeHalfWidth);
+    
+    /**
+     * @brief Runs the replications
+     * @return One estimate per algorithm, in the order they were added
+     * 
+     * If a run throws, the exception is rethrown once the replications in
+     * flight have finished.
+     */
+    vector<ReplicationEstimate> run();
+    
+    /**
+     * @brief Gets the CSV column name of a metric
+     * @param metric Metric
+     * @return Name such as "avg_turnaround"
+     */
+    static const char* metricName(ReplicatedMetric metric);
+    
+    /**
+     * @brief Writes estimates as an aligned text table of mean +/- half-width
+     * @param out Stream to write to
+     * @param estimates Estimates from run()
+     */
+    static void writeTable(ostream& out, const vector<ReplicationEstimate>& estimates);
+    
+    /**
+     * @brief Writes estimates as CSV with one row per algorithm and metric
+     * @param out Stream to write to
+     * @param estimates Estimates from run()
+     */
+    static void writeCsv(ostream& out, const vector<ReplicationEstimate>& estimates);
+    
+    /**
+     * @brief Writes estimates as a JSON array with one object per algorithm
+     * @param out Stream to write to
+     * @param estimates Estimates from run()
+     * 
+     * Half-widths that are infinite, below two replications, are null.
+     */
+    static void writeJson(ostream& out, const vector<ReplicationEstimate>& estimates);
+};
+
+#endif // REPLICATION_RUNNER_H
@@ -0,0 +1,167 @@
+#include "response_ratio_tree.h"
+#include "scheduler_stats.h"
+#include <algorithm>
+#include <limits>
+
+const size_t ResponseRatioTree::NONE;
+const long long ResponseRatioTree::NEVER = numeric_limits<long long>::max();
+
+namespace {
+    // Products of a time span and a burst can exceed 64 bits
+    typedef __int128 wide;
+    
+    // Floor division for a positive divisor
+    wide floorDiv(wide numerator, wide divisor) {
+        wide quotient = numerator / divisor;
+        if (numerator % divisor != 0 && numerator < 0) {
+            quotient--;
+        }
+        return quotient;
+    }
+}
+
+ResponseRatioTree::ResponseRatioTree() : leaves(1), now(0) {
+    reset(0);
+}
+
+void ResponseRatioTree::reset(size_t capacity) {
+    leaves = 1;
+    while (leaves < capacity) {
+        leaves *= 2;
+    }
+    renew(winner);
+    renew(expiry);
+    renew(arrival);
+    renew(burst);
+    renew(order);
+    winner.assign(2 * leaves, NONE);
+    expiry.assign(2 * leaves, NEVER);
+    arrival.assign(capacity, 0);
+    burst.assign(capacity, 1);
+    order.assign(capacity, 0);
+    now = 0;
+}
+
+void ResponseRatioTree::grow(size_t capacity) {
+    if (capacity <= arrival.size()) {
+        return;
+    }
+    arrival.resize(capacity, 0);
+    burst.resize(capacity, 1);
+    order.resize(capacity, 0);
+    if (capacity <= leaves) {
+        return;
+    }
+    
+    // Rebuild the tournament over more leaves from the waiting jobs
+    size_t oldLeaves = leaves;
+    ScratchVector<size_t> waiting(winner.begin() + oldLeaves, winner.begin() + 2 * oldLeaves);
+    while (leaves < capacity) {
+        leaves *= 2;
+    }
+    winner.assign(2 * leaves, NONE);
+    expiry.assign(2 * leaves, NEVER);
+    for (size_t id = 0; id < oldLeaves; id++) {
+        winner[leaves + id] = waiting[id];
+    }
+    for (size_t node = leaves - 1; node >= 1; node--) {
+        recompute(node);
+    }
+}
+
+bool ResponseRatioTree::empty() const {
+    return winner[1] == NONE;
+}
+
+bool ResponseRatioTree::beats(size_t a, size_t b, long long time) const {
+    // (time - arrival + burst) / burst compared by cross-multiplication
+    wide ratioA = static_cast<wide>(time - arrival[a] + burst[a]) * burst[b];
+    wide ratioB = static_cast<wide>(time - arrival[b] + burst[b]) * burst[a];
+    if (ratioA != ratioB) {
+        return ratioA > ratioB;
+    }
+    return order[a] < order[b];
+}
+
+long long ResponseRatioTree::overtakeTime(size_t leader, size_t challenger, long long time) const {
+    // The challenger is ahead once
+    //   slope * t + offset > 0   (or >= 0 if it arrived first)
+    // where slope = burst[leader] - burst[challenger]. A challenger with an
+    // equal or longer burst grows no faster, so it never catches up.
+    wide slope = static_cast<wide>(burst[leader]) - burst[challenger];
+    if (slope <= 0) {
+        return NEVER;
+    }
+    
+    wide offset = static_cast<wide>(burst[challenger] - static_cast<long long>(arrival[challenger])) * burst[leader]
+                - static_cast<wide>(burst[leader] - static_cast<long long>(arrival[leader])) * burst[challenger];
+    wide crossing = order[challenger] < order[leader]
+                  ? -floorDiv(offset, slope)          // ceil(-offset / slope)
+                  : floorDiv(-offset, slope) + 1;     // first t strictly past the crossing
+    
+    if (crossing <= time) {
+        crossing = time + 1;
+    }
+    if (crossing >= static_cast<wide>(NEVER)) {
+        return NEVER;
+    }
+    return static_cast<long long>(crossing);
+}
+
+void ResponseRatioTree::recompute(size_t node) {
+    INSTRUMENT(scannedEntries += 2;)
+    size_t left = winner[2 * node];
+    size_t right = winner[2 * node + 1];
+    long long certificate = NEVER;
+    
+    if (left == NONE) {
+        winner[node] = right;
+    } else if (right == NONE) {
+        winner[node] = left;
+    } else if (beats(left, right, now)) {
+        winner[node] = left;
+        certificate = overtakeTime(left, right, now);
+    } else {
+        winner[node] = right;
+        certificate = overtakeTime(right, left, now);
+    }
+    
+    expiry[node] = min(certificate, min(expiry[2 * node], expiry[2 * node + 1]));
+}
+
+void ResponseRatioTree::advanceNode(size_t node) {
+    if (expiry[node] > now || node >= leaves) {
+        return;
+    }
+    advanceNode(2 * node);
+    advanceNode(2 * node + 1);
+    recompute(node);
+}
+
+void ResponseRatioTree::advance(long long time) {
+    now = time;
+    advanceNode(1);
+}
+
+void ResponseRatioTree::updatePath(size_t id) {
+    for (size_t node = (leaves + id) / 2; node >= 1; node /= 2) {
+        recompute(node);
+    }
+}
+
+void ResponseRatioTree::insert(size_t id, int arrivalTime, int burstTime, uint64_t arrivalOrder) {
+    arrival[id] = arrivalTime;
+    burst[id] = burstTime;
+    order[id] = arrivalOrder;
+    winner[leaves + id] = id;
+    updatePath(id);
+}
+
+void ResponseRatioTree::erase(size_t id) {
+    winner[leaves + id] = NONE;
+    updatePath(id);
+}
+
+size_t ResponseRatioTree::top() const {
+    return winner[1];
+}
@@ -0,0 +1,97 @@
+#ifndef RESPONSE_RATIO_TREE_H
+#define RESPONSE_RATIO_TREE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "scratch_arena.h"
+
+using namespace std;
+
+/**
+ * @class ResponseRatioTree
+ * @brief Kinetic tournament tree that tracks the highest response ratio over time
+ * 
+ * A waiting job's response ratio 1 + (t - arrival) / burst is a line in t,
+ * so the job with the highest ratio only changes where two lines cross.
+ * Every internal node keeps the winner of its two children together with
+ * the first time at which that winner would lose ("certificate failure").
+ * Advancing the clock only revisits subtrees whose certificates have
+ * expired, and inserting or erasing a job recomputes one leaf-to-root
+ * path, so the best job is available in O(1) and updates cost O(log n).
+ * 
+ * Ratios are compared exactly with integer cross-multiplication. Equal
+ * ratios go to the job that arrived first, which matches a scan in arrival
+ * order that keeps the first strictly greater ratio. Time must never move
+ * backwards. Storage comes from the thread's ScratchArena.
+ */
+class ResponseRatioTree {
+private:
+    static const size_t NONE = static_cast<size_t>(-1);
+    static const long long NEVER;
+
+    size_t leaves;                      // Number of leaf slots (power of two)
+    ScratchVector<size_t> winner;       // Winning ID of each node, or NONE
+    ScratchVector<long long> expiry;    // Earliest certificate failure in each subtree
+    ScratchVector<int> arrival;         // Arrival time of each ID
+    ScratchVector<int> burst;           // Burst time of each ID
+    ScratchVector<uint64_t> order;      // Arrival order of each ID, the tie-break
+    long long now;                      // Time the tree is valid for
+
+    bool beats(size_t a, size_t b, long long time) const;
+    long long overtakeTime(size_t leader, size_t challenger, long long time) const;
+    void recompute(size_t node);
+    void advanceNode(size_t node);
+    void updatePath(size_t id);
+
+public:
+    /**
+     * @brief Constructor for ResponseRatioTree
+     */
+    ResponseRatioTree();
+
+    /**
+     * @brief Empties the tree and sizes it for IDs below capacity
+     * @param capacity One past the largest ID that will be inserted
+     * 
+     * Takes fresh storage from the arena, so call it after the arena's reset.
+     */
+    void reset(size_t capacity);
+
+    /**
+     * @brief Sizes the tree for IDs below capacity, keeping waiting jobs and the clock
+     * @param capacity New upper bound on IDs; smaller values are ignored
+     */
+    void grow(size_t capacity);
+
+    bool empty() const;
+
+    /**
+     * @brief Moves the clock forward, replaying any crossings on the way
+     * @param time New current time, not earlier than the previous one
+     */
+    void advance(long long time);
+
+    /**
+     * @brief Adds a waiting job
+     * @param id ID below the capacity given to reset()
+     * @param arrivalTime Time at which the job arrived
+     * @param burstTime Burst time of the job, at least 1
+     * @param arrivalOrder Position in arrival order; equal ratios go to the lower one
+     */
+    void insert(size_t id, int arrivalTime, int burstTime, uint64_t arrivalOrder);
+
+    /**
+     * @brief Removes a waiting job
+     * @param id ID previously inserted
+     */
+    void erase(size_t id);
+
+    /**
+     * @brief Gets the job with the highest response ratio at the current time
+     * @return Winning ID
+     */
+    size_t top() const;
+};
+
+#endif // RESPONSE_RATIO_TREE_H
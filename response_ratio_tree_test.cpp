@@ -0,0 +1,197 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+
+#include "process_table.h"
+#include "hrrn_scheduler.h"
+#include "response_ratio_tree.h"
+#include "scratch_arena.h"
+
+using namespace std;
+
+// Checks ResponseRatioTree against a brute-force scan of the waiting jobs,
+// which is how HRRN picked the next process before the tree replaced it.
+// Workloads are seeded and random, with bursts drawn from a small set so
+// that equal ratios are common, and include jobs erased while waiting and
+// spans whose products need more than 64 bits. Exits with 1 on the first
+// mismatch.
+
+namespace {
+    typedef __int128 wide;
+    
+    struct Job {
+        int arrival;
+        int burst;
+    };
+    
+    // Highest response ratio at time now, keeping the first strictly
+    // greater one in arrival order
+    size_t scanBest(const vector<Job>& jobs, const vector<bool>& waiting, long long now) {
+        size_t best = jobs.size();
+        for (size_t id = 0; id < jobs.size(); id++) {
+            if (!waiting[id]) {
+                continue;
+            }
+            if (best == jobs.size()) {
+                best = id;
+                continue;
+            }
+            wide ratio = static_cast<wide>(now - jobs[id].arrival + jobs[id].burst) * jobs[best].burst;
+            wide bestRatio = static_cast<wide>(now - jobs[best].arrival + jobs[best].burst) * jobs[id].burst;
+            if (ratio > bestRatio) {
+                best = id;
+            }
+        }
+        return best;
+    }
+    
+    // Jobs in arrival order; several share each arrival time
+    vector<Job> generateJobs(mt19937_64& random, size_t count, bool huge) {
+        static const int SMALL_BURSTS[] = {1, 2, 3, 4, 6, 8, 12};
+        vector<Job> jobs(count);
+        long long arrival = 0;
+        for (Job& job : jobs) {
+            if (random() % 3 == 0) {
+                arrival += huge ? random() % 10000000 : random() % 5;
+            }
+            job.arrival = static_cast<int>(arrival);
+            job.burst = huge ? 1 + static_cast<int>(random() % 2000000000)
+                             : SMALL_BURSTS[random() % 7];
+        }
+        return jobs;
+    }
+    
+    bool fail(const string& test, size_t trial, const string& message) {
+        cerr << "FAIL " << test << " trial " << trial << ": " << message << endl;
+        return false;
+    }
+    
+    // Random advances, arrivals, dispatches and erasures, comparing the top
+    // of the tree with the scan after every step
+    bool testTreeOperations(size_t trials) {
+        mt19937_64 random(12345);
+        for (size_t trial = 0; trial < trials; trial++) {
+            bool huge = trial % 5 == 4;
+            vector<Job> jobs = generateJobs(random, 1 + random() % 200, huge);
+            vector<bool> waiting(jobs.size(), false);
+            size_t waitingCount = 0;
+            
+            // Start small so the tree has to grow as jobs arrive
+            ScratchArena::local().reset();
+            ResponseRatioTree tree;
+            size_t capacity = 1 + random() % jobs.size();
+            tree.reset(capacity);
+            
+            long long now = jobs[0].arrival;
+            size_t next = 0;
+            while (next < jobs.size() || waitingCount > 0) {
+                int action = static_cast<int>(random() % 10);
+                if (action < 3 || (waitingCount == 0 && next < jobs.size())) {
+                    // Move the clock, by a lot when the spans are huge
+                    now += huge ? static_cast<long long>(random() % 3000000000000LL) : random() % 7;
+                    if (waitingCount == 0 && next < jobs.size()) {
+                        now = max<long long>(now, jobs[next].arrival);
+                    }
+                    tree.advance(now);
+                    while (next < jobs.size() && jobs[next].arrival <= now) {
+                        if (next >= capacity) {
+                            capacity = min(jobs.size(), 2 * next + 1);
+                            tree.grow(capacity);
+                        }
+                        tree.insert(next, jobs[next].arrival, jobs[next].burst, next);
+                        waiting[next] = true;
+                        waitingCount++;
+                        next++;
+                    }
+                } else if (action < 7) {
+                    // Dispatch the best job
+                    if (waitingCount > 0) {
+                        size_t best = tree.top();
+                        tree.erase(best);
+                        waiting[best] = false;
+                        waitingCount--;
+                    }
+                } else if (waitingCount > 0) {
+                    // Take away any waiting job, as another CPU would
+                    size_t id = random() % jobs.size();
+                    while (!waiting[id]) {
+                        id = (id + 1) % jobs.size();
+                    }
+                    tree.erase(id);
+                    waiting[id] = false;
+                    waitingCount--;
+                }
+                
+                if (tree.empty() != (waitingCount == 0)) {
+                    return fail("tree operations", trial, "empty() disagrees with the waiting count");
+                }
+                if (waitingCount > 0 && tree.top() != scanBest(jobs, waiting, now)) {
+                    return fail("tree operations", trial, "tree picked job " + to_string(tree.top()) +
+                                " at time " + to_string(now) + ", scan picked job " +
+                                to_string(scanBest(jobs, waiting, now)));
+                }
+            }
+        }
+        return true;
+    }
+    
+    // Runs HRRNScheduler end to end and compares its completion times, which
+    // fix the dispatch order of a non-preemptive run, with a scan-based run
+    bool testSchedulerDispatch(size_t trials) {
+        mt19937_64 random(67890);
+        for (size_t trial = 0; trial < trials; trial++) {
+            vector<Job> jobs = generateJobs(random, 1 + random() % 300, false);
+            
+            vector<int> arrival, burst, priority(jobs.size(), 0), deadline(jobs.size(), 0);
+            vector<string> names;
+            for (size_t id = 0; id < jobs.size(); id++) {
+                arrival.push_back(jobs[id].arrival);
+                burst.push_back(jobs[id].burst);
+                names.push_back("P" + to_string(id + 1));
+            }
+            ProcessTable table(arrival, burst, priority, deadline, names);
+            HRRNScheduler scheduler(table);
+            SchedulerResult result = scheduler.run();
+            
+            vector<int> expected(jobs.size(), 0);
+            vector<bool> waiting(jobs.size(), false);
+            long long now = 0;
+            size_t next = 0;
+            for (size_t done = 0; done < jobs.size(); done++) {
+                if (next < jobs.size() && scanBest(jobs, waiting, now) == jobs.size()) {
+                    now = max<long long>(now, jobs[next].arrival);
+                }
+                while (next < jobs.size() && jobs[next].arrival <= now) {
+                    waiting[next++] = true;
+                }
+                size_t best = scanBest(jobs, waiting, now);
+                waiting[best] = false;
+                now += jobs[best].burst;
+                expected[best] = static_cast<int>(now);
+            }
+            
+            if (result.completions != expected) {
+                for (size_t id = 0; id < jobs.size(); id++) {
+                    if (result.completions[id] != expected[id]) {
+                        return fail("scheduler dispatch", trial, "P" + to_string(id + 1) + " completed at " +
+                                    to_string(result.completions[id]) + ", scan expects " +
+                                    to_string(expected[id]));
+                    }
+                }
+                return fail("scheduler dispatch", trial, "completion count differs");
+            }
+        }
+        return true;
+    }
+}
+
+int main() {
+    if (!testTreeOperations(2000) || !testSchedulerDispatch(500)) {
+        return 1;
+    }
+    
+    cout << "ResponseRatioTree matches the brute-force scan" << endl;
+    return 0;
+}
@@ -0,0 +1,631 @@
+#include "result_writer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    const size_t GANTT_WIDTH = 100;  // Characters of a text Gantt row before it wraps
+    
+    // One CPU's timeline: the single chart of a one-CPU run, or each CpuTrack
+    struct GanttTrack {
+        uint32_t cpu;
+        const vector<GanttSegment>* segments;
+    };
+    
+    vector<GanttTrack> ganttTracks(const SchedulerResult& result) {
+        vector<GanttTrack> tracks;
+        if (result.cpus.empty()) {
+            tracks.push_back({0, &result.ganttChart});
+        }
+        for (size_t cpu = 0; cpu < result.cpus.size(); cpu++) {
+            tracks.push_back({static_cast<uint32_t>(cpu), &result.cpus[cpu].ganttChart});
+        }
+        return tracks;
+    }
+    
+    // Whether the result has per-process times for every row of the table;
+    // streaming runs have none
+    bool hasProcessTimes(const ProcessTable& table, const SchedulerResult& result) {
+        return !table.empty() && result.completions.size() == table.size() &&
+               result.responses.size() == table.size();
+    }
+    
+    // The three latency distributions of a result, with their field names
+    struct NamedTail {
+        const char* name;
+        TailLatency tail;
+    };
+    
+    vector<NamedTail> tails(const SchedulerResult& result) {
+        return {{"turnaround", result.turnaroundTimes.tail()},
+                {"waiting", result.waitingTimes.tail()},
+                {"response", result.responseTimes.tail()}};
+    }
+    
+    void putCsvField(OutputBuffer& out, const string& text) {
+        if (text.find_first_of(",\"\n") == string::npos) {
+            out.put(text);
+            return;
+        }
+        out.put('"');
+        for (char c : text) {
+            if (c == '"') {
+                out.put('"');
+            }
+            out.put(c);
+        }
+        out.put('"');
+    }
+    
+    void putJsonString(OutputBuffer& out, const string& text) {
+        out.put('"');
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out.put('\\');
+                out.put(c);
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                static const char HEX[] = "0123456789abcdef";
+                out.put("\\u00", 4);
+                out.put(HEX[(c >> 4) & 0xF]);
+                out.put(HEX[c & 0xF]);
+            } else {
+                out.put(c);
+            }
+        }
+        out.put('"');
+    }
+    
+    // JSON has no NaN or infinity, which an empty run's averages can be
+    void putJsonNumber(OutputBuffer& out, double value) {
+        if (isfinite(value)) {
+            out.putDouble(value);
+        } else {
+            out.put("null", 4);
+        }
+    }
+    
+    void putBinaryString(OutputBuffer& out, const string& text) {
+        out.putRaw(static_cast<uint32_t>(text.size()));
+        out.put(text);
+    }
+    
+    /**
+     * The interactive menu's report: metrics, an optional per-process
+     * table and the Gantt chart, wrapped every GANTT_WIDTH characters.
+     */
+    class TextResultWriter : public ResultWriter {
+    private:
+        string lastWorkload;  // Workload whose heading was written last
+        
+        void writeSummary(const SchedulerResult& result) {
+            buffer.put("Average Turnaround Time: ");
+            buffer.putDouble(result.avgTurnaroundTime, "%.2f");
+            buffer.put("\nAverage Waiting Time: ");
+            buffer.putDouble(result.avgWaitingTime, "%.2f");
+            buffer.put("\nAverage Response Time: ");
+            buffer.putDouble(result.avgResponseTime, "%.2f");
+            buffer.put("\nCPU Utilization: ");
+            buffer.putDouble(result.cpuUtilization, "%.2f");
+            buffer.put("%\n");
+            writeTail("Turnaround Time", result.turnaroundTimes.tail());
+            writeTail("Waiting Time", result.waitingTimes.tail());
+            writeTail("Response Time", result.responseTimes.tail());
+        }
+        
+        void writeTail(const char* label, const TailLatency& tail) {
+            buffer.put(label);
+            buffer.put(" p50/p90/p99/p99.9/max: ");
+            const double values[] = {tail.p50, tail.p90, tail.p99, tail.p999, tail.max};
+            for (size_t i = 0; i < 5; i++) {
+                buffer.put(i == 0 ? "" : " / ");
+                buffer.putDouble(values[i], "%.0f");
+            }
+            buffer.put('\n');
+        }
+        
+        void writeProcesses(const ProcessTable& table, const SchedulerResult& result) {
+            if (!hasProcessTimes(table, result)) {
+                return;
+            }
+            char line[160];
+            snprintf(line, sizeof(line), "\n%-12s %8s %8s %8s %10s %10s %8s %8s\n", "Process", "Arrival",
+                     "Burst", "Priority", "Completion", "Turnaround", "Waiting", "Response");
+            buffer.put(line, strlen(line));
+            for (uint32_t pid = 0; pid < table.size(); pid++) {
+                int turnaround = result.completions[pid] - table.arrival[pid];
+                snprintf(line, sizeof(line), " %8d %8d %8d %10d %10d %8d %8d\n", table.arrival[pid],
+                         table.burst[pid], table.priority[pid], result.completions[pid], turnaround,
+                         turnaround - table.burst[pid], result.responses[pid]);
+                const string& name = table.name(pid);
+                buffer.put(name);
+                if (name.size() < 12) {
+                    buffer.put("            ", 12 - name.size());
+                }
+                buffer.put(line, strlen(line));
+            }
+        }
+        
+        // Process row with one cell per segment, and a time row with each
+        // boundary printed under the bar that closes the segment. Rows wrap
+        // so that long runs stay readable; the next pair starts at the
+        // boundary the previous one ended on.
+        void writeGantt(const string& title, const vector<GanttSegment>& chart, const SchedulerResult& result) {
+            buffer.put("\n");
+            buffer.put(title);
+            buffer.put(":\n");
+            string processRow = "|";
+            string timeRow = chart.empty() ? "" : to_string(chart.front().start);
+            bool wrapped = false;
+            for (const auto& segment : chart) {
+                processRow += " " + result.nameOf(segment.pid) + " |";
+                if (timeRow.size() < processRow.size() - 1) {
+                    timeRow.append(processRow.size() - 1 - timeRow.size(), ' ');
+                } else {
+                    timeRow += ' ';
+                }
+                timeRow += to_string(segment.end);
+                
+                if (processRow.size() >= GANTT_WIDTH) {
+                    buffer.put(processRow + "\n" + timeRow + "\n\n");
+                    processRow = "|";
+                    timeRow = to_string(segment.end);
+                    wrapped = true;
+                }
+            }
+            if (processRow.size() > 1 || !wrapped) {
+                buffer.put(processRow + "\n" + timeRow + "\n\n");
+            }
+        }
+    
+    public:
+        TextResultWriter(ostream& out, unsigned sections) : ResultWriter(out, sections) {}
+        
+        void write(const string& workload, const ProcessTable& table, const ComparisonEntry& entry) override {
+            if (!workload.empty() && workload != lastWorkload) {
+                buffer.put("\n##### " + workload + " (" + to_string(table.size()) + " processes) #####\n");
+                lastWorkload = workload;
+            }
+            const SchedulerResult& result = entry.result;
+            buffer.put("\n===== " + entry.algorithmName + " =====\n");
+            if (sections & SUMMARY_SECTION) {
+                writeSummary(result);
+            }
+            if (sections & PROCESS_SECTION) {
+                writeProcesses(table, result);
+            }
+            if (sections & GANTT_SECTION) {
+                for (const auto& track : ganttTracks(result)) {
+                    string title = result.cpus.empty() ? "Gantt Chart" : "Gantt Chart, CPU " + to_string(track.cpu);
+                    writeGantt(title, *track.segments, result);
+                }
+            }
+        }
+        
+        // Failures are reported where they happen; the report only has results
+        void writeFailure(const string& /*workload*/, const string& /*error*/) override {}
+    };
+    
+    /**
+     * One CSV table for the chosen section, with the workload and
+     * algorithm on every row. Failures get a summary row with the error.
+     */
+    class CsvResultWriter : public ResultWriter {
+    private:
+        void putRunFields(const string& workload, const string& algorithm) {
+            putCsvField(buffer, workload);
+            buffer.put(',');
+            putCsvField(buffer, algorithm);
+        }
+    
+    public:
+        CsvResultWriter(ostream& out, unsigned sections) : ResultWriter(out, sections) {
+            if (sections == SUMMARY_SECTION) {
+                buffer.put("workload,algorithm,processes,avg_turnaround,avg_waiting,avg_response,throughput,"
+                           "cpu_utilization,steals");
+                for (const char* metric : {"turnaround", "waiting", "response"}) {
+                    for (const char* statistic : {"p50", "p90", "p99", "p999", "max"}) {
+                        buffer.put(string(",") + metric + "_" + statistic);
+                    }
+                }
+                buffer.put(",error\n");
+            } else if (sections == PROCESS_SECTION) {
+                buffer.put("workload,algorithm,pid,process,arrival,burst,priority,completion,turnaround,"
+                           "waiting,response\n");
+            } else {
+                buffer.put("workload,algorithm,cpu,process,start,end\n");
+            }
+        }
+        
+        void write(const string& workload, const ProcessTable& table, const ComparisonEntry& entry) override {
+            const SchedulerResult& result = entry.result;
+            if (sections == SUMMARY_SECTION) {
+                putRunFields(workload, entry.algorithmName);
+                buffer.put(',');
+                buffer.putInt(static_cast<long long>(table.size()));
+                for (double value : {result.avgTurnaroundTime, result.avgWaitingTime, result.avgResponseTime,
+                                     result.throughput, result.cpuUtilization}) {
+                    buffer.put(',');
+                    buffer.putDouble(value);
+                }
+                buffer.put(',');
+                buffer.putInt(static_cast<long long>(result.steals));
+                for (const auto& named : tails(result)) {
+                    const TailLatency& tail = named.tail;
+                    for (double value : {tail.p50, tail.p90, tail.p99, tail.p999, tail.max}) {
+                        buffer.put(',');
+                        buffer.putDouble(value);
+                    }
+                }
+                buffer.put(",\n");
+            } else if (sections == PROCESS_SECTION) {
+                if (!hasProcessTimes(table, result)) {
+                    return;
+                }
+                for (uint32_t pid = 0; pid < table.size(); pid++) {
+                    int turnaround = result.completions[pid] - table.arrival[pid];
+                    putRunFields(workload, entry.algorithmName);
+                    buffer.put(',');
+                    buffer.putInt(pid);
+                    buffer.put(',');
+                    putCsvField(buffer, table.name(pid));
+                    for (int value : {table.arrival[pid], table.burst[pid], table.priority[pid],
+                                      result.completions[pid], turnaround, turnaround - table.burst[pid],
+                                      result.responses[pid]}) {
+                        buffer.put(',');
+                        buffer.putInt(value);
+                    }
+                    buffer.put('\n');
+                }
+            } else {
+                for (const auto& track : ganttTracks(result)) {
+                    for (const auto& segment : *track.segments) {
+                        putRunFields(workload, entry.algorithmName);
+                        buffer.put(',');
+                        buffer.putInt(track.cpu);
+                        buffer.put(',');
+                        putCsvField(buffer, result.nameOf(segment.pid));
+                        buffer.put(',');
+                        buffer.putInt(segment.start);
+                        buffer.put(',');
+                        buffer.putInt(segment.end);
+                        buffer.put('\n');
+                    }
+                }
+            }
+        }
+        
+        void writeFailure(const string& workload, const string& error) override {
+            if (sections != SUMMARY_SECTION) {
+                return;
+            }
+            putCsvField(buffer, workload);
+            buffer.put(string(24, ','));
+            putCsvField(buffer, error);
+            buffer.put('\n');
+        }
+    };
+    
+    /**
+     * A JSON array with one object per run: workload, algorithm and
+     * process_count, then summary, processes and gantt as chosen.
+     */
+    class JsonResultWriter : public ResultWriter {
+    private:
+        bool empty;  // Whether no object has been written yet
+        
+        void beginObject() {
+            buffer.put(empty ? "\n  {" : ",\n  {");
+            empty = false;
+        }
+        
+        void writeSummary(const SchedulerResult& result) {
+            buffer.put(", \"summary\": {\"avg_turnaround\": ");
+            putJsonNumber(buffer, result.avgTurnaroundTime);
+            buffer.put(", \"avg_waiting\": ");
+            putJsonNumber(buffer, result.avgWaitingTime);
+            buffer.put(", \"avg_response\": ");
+            putJsonNumber(buffer, result.avgResponseTime);
+            buffer.put(", \"throughput\": ");
+            putJsonNumber(buffer, result.throughput);
+            buffer.put(", \"cpu_utilization\": ");
+            putJsonNumber(buffer, result.cpuUtilization);
+            buffer.put(", \"steals\": ");
+            buffer.putInt(static_cast<long long>(result.steals));
+            for (const auto& named : tails(result)) {
+                const TailLatency& tail = named.tail;
+                buffer.put(string(", \"") + named.name + "\": {\"p50\": ");
+                putJsonNumber(buffer, tail.p50);
+                buffer.put(", \"p90\": ");
+                putJsonNumber(buffer, tail.p90);
+                buffer.put(", \"p99\": ");
+                putJsonNumber(buffer, tail.p99);
+                buffer.put(", \"p999\": ");
+                putJsonNumber(buffer, tail.p999);
+                buffer.put(", \"max\": ");
+                putJsonNumber(buffer, tail.max);
+                buffer.put('}');
+            }
+            buffer.put('}');
+        }
+        
+        void writeProcesses(const ProcessTable& table, const SchedulerResult& result) {
+            buffer.put(", \"processes\": [");
+            if (hasProcessTimes(table, result)) {
+                for (uint32_t pid = 0; pid < table.size(); pid++) {
+                    int turnaround = result.completions[pid] - table.arrival[pid];
+                    buffer.put(pid == 0 ? "\n    {\"id\": " : ",\n    {\"id\": ");
+                    putJsonString(buffer, table.name(pid));
+                    buffer.put(", \"arrival\": ");
+                    buffer.putInt(table.arrival[pid]);
+                    buffer.put(", \"burst\": ");
+                    buffer.putInt(table.burst[pid]);
+                    buffer.put(", \"priority\": ");
+                    buffer.putInt(table.priority[pid]);
+                    buffer.put(", \"completion\": ");
+                    buffer.putInt(result.completions[pid]);
+                    buffer.put(", \"turnaround\": ");
+                    buffer.putInt(turnaround);
+                    buffer.put(", \"waiting\": ");
+                    buffer.putInt(turnaround - table.burst[pid]);
+                    buffer.put(", \"response\": ");
+                    buffer.putInt(result.responses[pid]);
+                    buffer.put('}');
+                }
+                buffer.put("\n  ");
+            }
+            buffer.put(']');
+        }
+        
+        void writeGantt(const SchedulerResult& result) {
+            buffer.put(", \"gantt\": [");
+            bool first = true;
+            for (const auto& track : ganttTracks(result)) {
+                for (const auto& segment : *track.segments) {
+                    buffer.put(first ? "\n    {\"cpu\": " : ",\n    {\"cpu\": ");
+                    first = false;
+                    buffer.putInt(track.cpu);
+                    buffer.put(", \"process\": ");
+                    putJsonString(buffer, result.nameOf(segment.pid));
+                    buffer.put(", \"start\": ");
+                    buffer.putInt(segment.start);
+                    buffer.put(", \"end\": ");
+                    buffer.putInt(segment.end);
+                    buffer.put('}');
+                }
+            }
+            buffer.put(first ? "]" : "\n  ]");
+        }
+    
+    public:
+        JsonResultWriter(ostream& out, unsigned sections) : ResultWriter(out, sections), empty(true) {
+            buffer.put('[');
+        }
+        
+        void write(const string& workload, const ProcessTable& table, const ComparisonEntry& entry) override {
+            beginObject();
+            if (!workload.empty()) {
+                buffer.put("\"workload\": ");
+                putJsonString(buffer, workload);
+                buffer.put(", ");
+            }
+            buffer.put("\"algorithm\": ");
+            putJsonString(buffer, entry.algorithmName);
+            buffer.put(", \"process_count\": ");
+            buffer.putInt(static_cast<long long>(table.size()));
+            if (sections & SUMMARY_SECTION) {
+                writeSummary(entry.result);
+            }
+            if (sections & PROCESS_SECTION) {
+                writeProcesses(table, entry.result);
+            }
+            if (sections & GANTT_SECTION) {
+                writeGantt(entry.result);
+            }
+            buffer.put('}');
+        }
+        
+        void writeFailure(const string& workload, const string& error) override {
+            beginObject();
+            buffer.put("\"workload\": ");
+            putJsonString(buffer, workload);
+            buffer.put(", \"error\": ");
+            putJsonString(buffer, error);
+            buffer.put('}');
+        }
+        
+        void finish() override {
+            buffer.put(empty ? "]\n" : "\n]\n");
+            ResultWriter::finish();
+        }
+    };
+    
+    /**
+     * Native-endian records as laid out at BinaryResultRecord; columns and
+     * segments are copied in bulk.
+     */
+    class BinaryResultWriter : public ResultWriter {
+    private:
+        void putRecord(BinaryResultRecord type) {
+            buffer.putRaw(static_cast<uint32_t>(type));
+        }
+        
+        void putColumn(const vector<int>& column) {
+            buffer.put(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(int32_t));
+        }
+    
+    public:
+        BinaryResultWriter(ostream& out, unsigned sections) : ResultWriter(out, sections) {
+            buffer.put("CPUSRSLT", 8);
+            buffer.putRaw(static_cast<uint32_t>(1));
+            buffer.putRaw(static_cast<uint32_t>(0x01020304));
+        }
+        
+        void write(const string& workload, const ProcessTable& table, const ComparisonEntry& entry) override {
+            const SchedulerResult& result = entry.result;
+            putRecord(RUN_RECORD);
+            putBinaryString(buffer, workload);
+            putBinaryString(buffer, entry.algorithmName);
+            buffer.putRaw(static_cast<uint64_t>(table.size()));
+            
+            if (sections & SUMMARY_SECTION) {
+                putRecord(SUMMARY_RECORD);
+                for (double value : {result.avgTurnaroundTime, result.avgWaitingTime, result.avgResponseTime,
+                                     result.throughput, result.cpuUtilization}) {
+                    buffer.putRaw(value);
+                }
+                buffer.putRaw(static_cast<uint64_t>(result.steals));
+                for (const auto& named : tails(result)) {
+                    const TailLatency& tail = named.tail;
+                    for (double value : {tail.p50, tail.p90, tail.p99, tail.p999, tail.max}) {
+                        buffer.putRaw(value);
+                    }
+                }
+            }
+            if ((sections & PROCESS_SECTION) && hasProcessTimes(table, result)) {
+                putRecord(PROCESS_RECORD);
+                buffer.putRaw(static_cast<uint64_t>(table.size()));
+                putColumn(table.arrival);
+                putColumn(table.burst);
+                putColumn(table.priority);
+                putColumn(result.completions);
+                putColumn(result.responses);
+            }
+            if (sections & GANTT_SECTION) {
+                for (const auto& track : ganttTracks(result)) {
+                    putRecord(GANTT_RECORD);
+                    buffer.putRaw(track.cpu);
+                    buffer.putRaw(static_cast<uint64_t>(track.segments->size()));
+                    for (const auto& segment : *track.segments) {
+                        buffer.putRaw(segment.pid);
+                        buffer.putRaw(static_cast<int32_t>(segment.start));
+                        buffer.putRaw(static_cast<int32_t>(segment.end));
+                    }
+                }
+            }
+        }
+        
+        void writeFailure(const string& workload, const string& error) override {
+            putRecord(FAILURE_RECORD);
+            putBinaryString(buffer, workload);
+            putBinaryString(buffer, error);
+        }
+    };
+}
+
+OutputBuffer::OutputBuffer(ostream& out) : out(out) {
+    block.reserve(BLOCK_SIZE + 4096);
+}
+
+OutputBuffer::~OutputBuffer() {
+    drain();
+}
+
+void OutputBuffer::putInt(long long value) {
+    char digits[24];
+    char* end = digits + sizeof(digits);
+    char* start = end;
+    unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value) : value;
+    do {
+        *--start = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) {
+        *--start = '-';
+    }
+    put(start, static_cast<size_t>(end - start));
+}
+
+void OutputBuffer::putDouble(double value, const char* format) {
+    char text[64];
+    int length = snprintf(text, sizeof(text), format, value);
+    if (length > 0) {
+        put(text, min(static_cast<size_t>(length), sizeof(text) - 1));
+    }
+}
+
+void OutputBuffer::drain() {
+    if (!block.empty()) {
+        out.write(block.data(), static_cast<streamsize>(block.size()));
+        block.clear();
+    }
+}
+
+void OutputBuffer::flush() {
+    drain();
+    out.flush();
+    if (!out) {
+        throw runtime_error("Failed to write results");
+    }
+}
+
+ResultWriter::ResultWriter(ostream& out, unsigned sections) : buffer(out), sections(sections) {}
+
+unique_ptr<ResultWriter> ResultWriter::create(ResultFormat format, ostream& out, unsigned sections) {
+    if (sections == 0 || sections > (SUMMARY_SECTION | PROCESS_SECTION | GANTT_SECTION)) {
+        throw invalid_argument("No result section chosen");
+    }
+    switch (format) {
+        case TEXT_RESULTS:
+            return unique_ptr<ResultWriter>(new TextResultWriter(out, sections));
+        case CSV_RESULTS:
+            if (sections != SUMMARY_SECTION && sections != PROCESS_SECTION && sections != GANTT_SECTION) {
+                throw invalid_argument("CSV output holds one section; choose summary, processes or gantt");
+            }
+            return unique_ptr<ResultWriter>(new CsvResultWriter(out, sections));
+        case JSON_RESULTS:
+            return unique_ptr<ResultWriter>(new JsonResultWriter(out, sections));
+        case BINARY_RESULTS:
+            return unique_ptr<ResultWriter>(new BinaryResultWriter(out, sections));
+    }
+    throw invalid_argument("Unknown result format");
+}
+
+ResultFormat ResultWriter::parseFormat(const string& name) {
+    if (name == "text") {
+        return TEXT_RESULTS;
+    }
+    if (name == "csv") {
+        return CSV_RESULTS;
+    }
+    if (name == "json") {
+        return JSON_RESULTS;
+    }
+    if (name == "binary") {
+        return BINARY_RESULTS;
+    }
+    throw invalid_argument("Unknown format '" + name + "'; use text, csv, json or binary");
+}
+
+unsigned ResultWriter::parseSections(const string& list) {
+    unsigned sections = 0;
+    stringstream stream(list);
+    string name;
+    while (getline(stream, name, ',')) {
+        if (name == "summary") {
+            sections |= SUMMARY_SECTION;
+        } else if (name == "processes") {
+            sections |= PROCESS_SECTION;
+        } else if (name == "gantt") {
+            sections |= GANTT_SECTION;
+        } else {
+            throw invalid_argument("Unknown section '" + name + "'; use summary, processes or gantt");
+        }
+    }
+    if (sections == 0) {
+        throw invalid_argument("No result section chosen");
+    }
+    return sections;
+}
+
+void ResultWriter::flush() {
+    buffer.flush();
+}
+
+void ResultWriter::finish() {
+    buffer.flush();
+}
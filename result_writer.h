@@ -0,0 +1,237 @@
+#ifndef RESULT_WRITER_H
+#define RESULT_WRITER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include "process_table.h"
+#include "comparison_runner.h"
+
+using namespace std;
+
+/**
+ * @enum ResultFormat
+ * @brief Encodings a ResultWriter can produce
+ */
+enum ResultFormat {
+    TEXT_RESULTS,     // The interactive menu's report
+    CSV_RESULTS,      // One table with a header line; one section only
+    JSON_RESULTS,     // One document holding an array of runs
+    BINARY_RESULTS    // Native-endian records, described at BinaryResultRecord
+};
+
+/**
+ * @enum ResultSection
+ * @brief Parts of a run a ResultWriter writes, combined as bit flags
+ */
+enum ResultSection {
+    SUMMARY_SECTION = 1,    // Averages, throughput, utilization and latency percentiles
+    PROCESS_SECTION = 2,    // Completion, turnaround, waiting and response time of every process
+    GANTT_SECTION = 4       // Gantt segments of every CPU
+};
+
+/**
+ * @enum BinaryResultRecord
+ * @brief Record types of the binary result format
+ * 
+ * A file starts with the 8 bytes "CPUSRSLT", a uint32_t version (1) and
+ * the uint32_t 0x01020304 in the producer's byte order. Records follow,
+ * each a uint32_t type and then its fields; strings are a uint32_t length
+ * and that many bytes.
+ *   RUN_RECORD:      workload, algorithm, uint64_t processes. Starts every
+ *                    run; the records up to the next RUN_RECORD belong to it
+ *   SUMMARY_RECORD:  double avgTurnaround, avgWaiting, avgResponse,
+ *                    throughput, cpuUtilization; uint64_t steals; then
+ *                    double p50, p90, p99, p99.9 and max of turnaround,
+ *                    waiting and response times
+ *   PROCESS_RECORD:  uint64_t count, then int32_t columns of count values:
+ *                    arrival, burst, priority, completion, response
+ *   GANTT_RECORD:    uint32_t cpu, uint64_t count, then count segments of
+ *                    uint32_t pid (0xFFFFFFFF when idle), int32_t start, end
+ *   FAILURE_RECORD:  workload, error
+ */
+enum BinaryResultRecord {
+    RUN_RECORD = 1,
+    SUMMARY_RECORD = 2,
+    PROCESS_RECORD = 3,
+    GANTT_RECORD = 4,
+    FAILURE_RECORD = 5
+};
+
+/**
+ * @class OutputBuffer
+ * @brief Collects output in memory and hands it to a stream in large blocks
+ * 
+ * Formatting a result touches the stream once per block rather than once
+ * per value or line, and never flushes it on its own.
+ */
+class OutputBuffer {
+private:
+    static const size_t BLOCK_SIZE = 1 << 20;  // Bytes collected before they are written
+    
+    ostream& out;    // Destination
+    string block;    // Bytes not yet written
+
+public:
+    /**
+     * @brief Constructor for OutputBuffer
+     * @param out Stream the blocks are written to
+     */
+    explicit OutputBuffer(ostream& out);
+    
+    /**
+     * @brief Writes what is left to the stream
+     */
+    ~OutputBuffer();
+    
+    /**
+     * @brief Appends bytes
+     * @param data Bytes to append
+     * @param size Number of bytes
+     */
+    void put(const char* data, size_t size) {
+        block.append(data, size);
+        if (block.size() >= BLOCK_SIZE) {
+            drain();
+        }
+    }
+    
+    /**
+     * @brief Appends a string's characters
+     * @param text Text to append
+     */
+    void put(const string& text) {
+        put(text.data(), text.size());
+    }
+    
+    /**
+     * @brief Appends a null-terminated string's characters
+     * @param text Text to append
+     */
+    void put(const char* text) {
+        put(text, strlen(text));
+    }
+    
+    /**
+     * @brief Appends one character
+     * @param c Character to append
+     */
+    void put(char c) {
+        block += c;
+        if (block.size() >= BLOCK_SIZE) {
+            drain();
+        }
+    }
+    
+    /**
+     * @brief Appends an integer in decimal
+     * @param value Integer to append
+     */
+    void putInt(long long value);
+    
+    /**
+     * @brief Appends a number with a printf conversion
+     * @param value Number to append
+     * @param format Conversion for one double, such as "%.2f"
+     */
+    void putDouble(double value, const char* format = "%.10g");
+    
+    /**
+     * @brief Appends the bytes of a value as they are in memory
+     * @param value Value to append
+     */
+    template <typename T>
+    void putRaw(const T& value) {
+        put(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    
+    /**
+     * @brief Writes the collected bytes to the stream without flushing it
+     */
+    void drain();
+    
+    /**
+     * @brief Writes the collected bytes and flushes the stream
+     * 
+     * Throws runtime_error if the stream has failed.
+     */
+    void flush();
+};
+
+/**
+ * @class ResultWriter
+ * @brief Writes the results of scheduler runs in one format
+ * 
+ * Build one with create(), pass it every run with write(), and call
+ * finish() once at the end. Output is buffered by an OutputBuffer, so
+ * nothing reaches the stream before a block fills or flush() is called.
+ */
+class ResultWriter {
+protected:
+    OutputBuffer buffer;    // Formatted output not yet written
+    unsigned sections;      // ResultSection flags to write
+    
+    ResultWriter(ostream& out, unsigned sections);
+
+public:
+    /**
+     * @brief Builds a writer
+     * @param format Encoding to write
+     * @param out Stream to write to; must outlive the writer
+     * @param sections ResultSection flags to write, at least one; CSV takes exactly one
+     * @return The writer
+     * 
+     * Throws invalid_argument for a section combination the format cannot hold.
+     */
+    static unique_ptr<ResultWriter> create(ResultFormat format, ostream& out, unsigned sections);
+    
+    /**
+     * @brief Parses a format name
+     * @param name text, csv, json or binary
+     * @return The format; throws invalid_argument for another name
+     */
+    static ResultFormat parseFormat(const string& name);
+    
+    /**
+     * @brief Parses a comma-separated list of section names
+     * @param list Any of summary, processes and gantt, such as "summary,gantt"
+     * @return ResultSection flags; throws invalid_argument for an unknown name
+     */
+    static unsigned parseSections(const string& list);
+    
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~ResultWriter() = default;
+    
+    /**
+     * @brief Writes one algorithm's run
+     * @param workload Name of the workload, or empty to leave it out
+     * @param table Workload the run simulated, for the per-process section
+     * @param entry Algorithm name and result of the run
+     */
+    virtual void write(const string& workload, const ProcessTable& table, const ComparisonEntry& entry) = 0;
+    
+    /**
+     * @brief Records a workload that could not be loaded or run
+     * @param workload Name of the workload
+     * @param error Why it failed
+     */
+    virtual void writeFailure(const string& workload, const string& error) = 0;
+    
+    /**
+     * @brief Writes everything so far to the stream and flushes it
+     */
+    void flush();
+    
+    /**
+     * @brief Ends the output, closing any open document, and flushes it
+     */
+    virtual void finish();
+};
+
+#endif // RESULT_WRITER_H
@@ -0,0 +1,106 @@
+#ifndef RING_QUEUE_H
+#define RING_QUEUE_H
+
+#include <vector>
+#include <cstddef>
+#include "scheduler_stats.h"
+#include "scratch_arena.h"
+
+using namespace std;
+
+/**
+ * @class RingQueue
+ * @brief Fixed-capacity FIFO queue on a circular buffer
+ * 
+ * Storage is taken from the thread's ScratchArena by reset(), after which
+ * push and pop are O(1) with no allocation. Pushing into a full queue is not allowed; grow() it
+ * first.
+ * 
+ * @tparam T Element type, trivially destructible
+ */
+template <typename T>
+class RingQueue {
+private:
+    ScratchVector<T> slots;  // Circular storage
+    size_t head;             // Slot of the front element
+    size_t count;            // Number of queued elements
+
+public:
+    /**
+     * @brief Constructor for RingQueue
+     */
+    RingQueue() : head(0), count(0) {}
+
+    /**
+     * @brief Empties the queue and sizes it to hold capacity elements
+     * @param capacity Maximum number of elements queued at once
+     * 
+     * Takes fresh storage from the arena, so call it after the arena's reset.
+     */
+    void reset(size_t capacity) {
+        renew(slots);
+        slots.assign(capacity, T());
+        head = 0;
+        count = 0;
+    }
+
+    /**
+     * @brief Enlarges the buffer to hold capacity elements, keeping contents in order
+     * @param capacity New maximum; smaller values are ignored
+     */
+    void grow(size_t capacity) {
+        if (capacity <= slots.size()) {
+            return;
+        }
+        ScratchVector<T> larger(capacity);
+        for (size_t i = 0; i < count; i++) {
+            size_t slot = head + i;
+            if (slot >= slots.size()) {
+                slot -= slots.size();
+            }
+            larger[i] = slots[slot];
+        }
+        slots.swap(larger);
+        head = 0;
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    size_t capacity() const { return slots.size(); }
+
+    /**
+     * @brief Appends an element at the back
+     * @param value Element to append
+     */
+    void push(const T& value) {
+        size_t slot = head + count;
+        if (slot >= slots.size()) {
+            slot -= slots.size();
+        }
+        slots[slot] = value;
+        count++;
+    }
+
+    /**
+     * @brief Gets the front element without removing it
+     * @return Front element
+     */
+    const T& front() const { return slots[head]; }
+
+    /**
+     * @brief Removes and returns the front element
+     * @return Former front element
+     */
+    T pop() {
+        INSTRUMENT(scannedEntries++;)
+        T value = slots[head];
+        head++;
+        if (head == slots.size()) {
+            head = 0;
+        }
+        count--;
+        return value;
+    }
+};
+
+#endif // RING_QUEUE_H
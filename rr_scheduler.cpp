@@ -1,96 +1,63 @@
 #include "rr_scheduler.h"
 #include <algorithm>
-#include <queue>
 
 RRScheduler::RRScheduler(const vector<Process>& processes, int timeQuantum)
     : Scheduler(processes), timeQuantum(timeQuantum) {}
 
-SchedulerResult RRScheduler::run() {
-    // Reset all processes and simulation time
-    resetProcesses();
-    
-    // Create a copy of processes to work with
-    vector<Process> processQueue = processes;
-    
-    // Sort processes by arrival time initially
-    sort(processQueue.begin(), processQueue.end(), 
-         [](const Process& a, const Process& b) {
-             return a.getArrivalTime() < b.getArrivalTime();
-         });
-    
-    // Ready queue for processes that have arrived
-    queue<Process*> readyQueue;
-    
-    // Current running process
-    Process* currentProcess = nullptr;
-    
-    // Time left in current time quantum
-    int remainingQuantum = 0;
-    
-    // Track remaining processes
-    size_t completedProcesses = 0;
-    size_t totalProcesses = processQueue.size();
+RRScheduler::RRScheduler(const ProcessTable& table, int timeQuantum)
+    : Scheduler(table), timeQuantum(timeQuantum) {}
+
+void RRScheduler::resetReadyQueue(size_t capacity) {
+    // A process is either running or queued once, so the ring never
+    // needs more than one slot per process
+    readyQueues.resize(readyQueueCount());
+    for (auto& readyQueue : readyQueues) {
+        readyQueue.reset(capacity);
+    }
+}
+
+void RRScheduler::growReadyQueue(size_t capacity) {
+    for (auto& readyQueue : readyQueues) {
+        readyQueue.grow(capacity);
+    }
+}
+
+void RRScheduler::enqueue(uint32_t pid, size_t queue) {
+    readyQueues[queue].push(pid);
+}
+
+uint32_t RRScheduler::dequeue(size_t queue) {
+    if (readyQueues[queue].empty()) {
+        return NO_PID;
+    }
     
-    // Main scheduling loop
-    while (completedProcesses < totalProcesses) {
-        // Check for newly arrived processes
-        for (auto& process : processQueue) {
-            if (process.getArrivalTime() <= currentTime && 
-                process.getRemainingTime() > 0 && 
-                !process.hasStarted()) {
-                readyQueue.push(&process);
-            }
-        }
-        
-        // If current process has finished its time quantum or is completed
-        if (currentProcess != nullptr && 
-            (remainingQuantum == 0 || currentProcess->getRemainingTime() == 0)) {
-            
-            // If process still has work to do, put it back in the ready queue
-            if (currentProcess->getRemainingTime() > 0) {
-                readyQueue.push(currentProcess);
-            } else {
-                // Process is completed
-                currentProcess->setCompletionTime(currentTime);
-                completedProcesses++;
-            }
-            
-            // Reset current process
-            currentProcess = nullptr;
-            remainingQuantum = 0;
-        }
-        
-        // If no current process, get the next one from ready queue
-        if (currentProcess == nullptr && !readyQueue.empty()) {
-            currentProcess = readyQueue.front();
-            readyQueue.pop();
-            remainingQuantum = timeQuantum;
-            
-            // Set response time if this is the first time process gets CPU
-            if (!currentProcess->hasStarted()) {
-                currentProcess->setResponseTime(currentTime - currentProcess->getArrivalTime());
-            }
-        }
-        
-        // If we have a process to run
-        if (currentProcess != nullptr) {
-            // Execute process for 1 time unit
-            currentProcess->execute(1);
-            remainingQuantum--;
-            
-            // Add to Gantt chart
-            ganttChart.push_back({currentProcess->getId(), currentTime});
-        } else {
-            // CPU is idle
-            ganttChart.push_back({"IDLE", currentTime});
-        }
-        
-        // Advance simulation time
-        currentTime++;
+    return readyQueues[queue].pop();
+}
+
+int RRScheduler::sliceLength(uint32_t running, size_t queue) const {
+    // Run for a whole quantum, or less if the process finishes first
+    int remaining = jobs.remaining[running];
+    if (remaining <= timeQuantum || !readyQueues[queue].empty()) {
+        return min(timeQuantum, remaining);
     }
     
-    // Calculate and return metrics
-    return calculateMetrics();
+    // With nobody to take turns with, quanta run back to back until the
+    // first quantum boundary at or after the next arrival. Other CPUs only
+    // ever take from this queue, so it stays empty until then.
+    long long untilArrival = static_cast<long long>(nextArrivalTime()) - currentTime;
+    long long quanta = max(1LL, (untilArrival + timeQuantum - 1) / timeQuantum);
+    return static_cast<int>(min(static_cast<long long>(remaining), quanta * timeQuantum));
+}
+
+bool RRScheduler::shouldPreempt(uint32_t /*running*/, size_t /*queue*/) const {
+    // A slice that did not complete the process always ends on quantum expiry.
+    // Arrivals at this instant were enqueued first, so the preempted process
+    // goes behind them.
+    return true;
+}
+
+void RRScheduler::setTimeQuantum(int timeQuantum) {
+    this->timeQuantum = timeQuantum;
 }
 
 string RRScheduler::getName() const {
@@ -2,6 +2,7 @@
 #define RR_SCHEDULER_H
 
 #include "scheduler.h"
+#include "ring_queue.h"
 
 /**
  * @class RRScheduler
@@ -13,6 +14,7 @@
 class RRScheduler : public Scheduler {
 private:
     int timeQuantum; // Time slice allocated to each process
+    vector<RingQueue<uint32_t>> readyQueues; // Circular ready queues, one slot per process each
 
 public:
     /**
@@ -23,10 +25,17 @@ public:
     RRScheduler(const vector<Process>& processes, int timeQuantum);
     
     /**
-     * @brief Runs the RR scheduling algorithm
-     * @return SchedulerResult containing all metrics
+     * @brief Constructor for RRScheduler
+     * @param table Process table to schedule
+     * @param timeQuantum Time slice allocated to each process
+     */
+    RRScheduler(const ProcessTable& table, int timeQuantum);
+    
+    /**
+     * @brief Changes the time quantum for later runs
+     * @param timeQuantum Time slice allocated to each process
      */
-    SchedulerResult run() override;
+    void setTimeQuantum(int timeQuantum);
     
     /**
      * @brief Gets the name of the scheduling algorithm
@@ -39,6 +48,49 @@ public:
      * @return String description of the algorithm
      */
     string getDescription() const override;
+
+protected:
+    /**
+     * @brief Empties the ready queues and sizes them for PIDs below capacity
+     * @param capacity One past the largest PID that will be enqueued
+     */
+    void resetReadyQueue(size_t capacity) override;
+
+    /**
+     * @brief Sizes the ready queues for PIDs below capacity, keeping their contents
+     * @param capacity New upper bound on PIDs
+     */
+    void growReadyQueue(size_t capacity) override;
+
+    /**
+     * @brief Adds a newly arrived process to the ready queue
+     * @param pid Process that has just arrived
+     * @param queue Ready queue to add it to
+     */
+    void enqueue(uint32_t pid, size_t queue) override;
+
+    /**
+     * @brief Removes and returns the next process to dispatch from a ready queue
+     * @param queue Ready queue to take it from
+     * @return Next process, or NO_PID if the ready queue is empty
+     */
+    uint32_t dequeue(size_t queue) override;
+
+    /**
+     * @brief Gets how long the running process may execute before the next decision
+     * @param running Process currently on the CPU
+     * @param queue Ready queue of the CPU it runs on
+     * @return Slice length
+     */
+    int sliceLength(uint32_t running, size_t queue) const override;
+
+    /**
+     * @brief Decides at a slice boundary whether the running process gives up the CPU
+     * @param running Process currently on the CPU
+     * @param queue Ready queue of the CPU it runs on
+     * @return True if the running process should be preempted
+     */
+    bool shouldPreempt(uint32_t running, size_t queue) const override;
 };
 
 #endif // RR_SCHEDULER_H
\ No newline at end of file
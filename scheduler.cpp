@@ -1,48 +1,295 @@
 #include "scheduler.h"
+#include "scheduler_loop.h"
+#include <algorithm>
+#include <limits>
 #include <numeric>
+#include <utility>
+#include <stdexcept>
+
+string SchedulerResult::nameOf(uint32_t pid) const {
+    if (pid == NO_PID) {
+        return "IDLE";
+    }
+    return (*processNames)[pid];
+}
 
 Scheduler::Scheduler(const vector<Process>& processes)
-    : processes(processes), currentTime(0) {}
+    : table(&ownedTable), workload(&ownedTable), ownedTable(processes), 
+      currentTime(0), nextArrival(0), cpuCount(1), queueMode(PER_CPU_QUEUES), 
+      steals(0), source(nullptr), sink(nullptr), 
+      lookahead("", 0, 0), hasLookahead(false), admitted(0), streamWorkEnd(0), queueCapacity(0), 
+      completedProcesses(0), totalTurnaroundTime(0), totalWaitingTime(0), 
+      totalResponseTime(0), busyTime(0) {}
 
-SchedulerResult Scheduler::calculateMetrics() {
-    SchedulerResult result;
-    result.ganttChart = ganttChart;
+Scheduler::Scheduler(const ProcessTable& table)
+    : table(&table), workload(&table), 
+      currentTime(0), nextArrival(0), cpuCount(1), queueMode(PER_CPU_QUEUES), 
+      steals(0), source(nullptr), sink(nullptr), 
+      lookahead("", 0, 0), hasLookahead(false), admitted(0), streamWorkEnd(0), queueCapacity(0), 
+      completedProcesses(0), totalTurnaroundTime(0), totalWaitingTime(0), 
+      totalResponseTime(0), busyTime(0) {}
+
+SchedulerResult Scheduler::run() {
+    table = workload;
+    ScratchArena::local().reset();
+    startInstrumentation();
+    resetReadyQueue(table->size());
+    return simulateRun();
+}
+
+void Scheduler::setCpus(size_t cpus, QueueMode mode) {
+    if (cpus < 1) {
+        throw invalid_argument("A scheduler needs at least one CPU");
+    }
+    cpuCount = cpus;
+    queueMode = mode;
+}
+
+size_t Scheduler::getCpuCount() const {
+    return cpuCount;
+}
+
+QueueMode Scheduler::getQueueMode() const {
+    return queueMode;
+}
+
+size_t Scheduler::readyQueueCount() const {
+    return queueMode == PER_CPU_QUEUES ? cpuCount : 1;
+}
+
+SchedulerResult Scheduler::runStreaming(ArrivalSource& arrivals, CompletionSink* completions) {
+    // Live processes get rows of their own, which are reused as they complete
+    liveRows.clear();
+    table = &liveRows;
+    ScratchArena::local().reset();
+    startInstrumentation();
+    renew(freeSlots);
+    queueCapacity = 0;
+    resetReadyQueue(queueCapacity);
     
-    // Calculate average metrics
-    double totalTurnaroundTime = 0;
-    double totalWaitingTime = 0;
-    double totalResponseTime = 0;
+    source = &arrivals;
+    sink = completions;
+    admitted = 0;
+    streamWorkEnd = 0;
+    hasLookahead = false;
+    pullLookahead();
     
-    for (const auto& process : processes) {
-        totalTurnaroundTime += process.getTurnaroundTime();
-        totalWaitingTime += process.getWaitingTime();
-        totalResponseTime += process.getResponseTime();
+    SchedulerResult result;
+    try {
+        result = simulateRun();
+    } catch (...) {
+        table = workload;
+        source = nullptr;
+        sink = nullptr;
+        throw;
     }
     
-    int numProcesses = processes.size();
-    result.avgTurnaroundTime = totalTurnaroundTime / numProcesses;
-    result.avgWaitingTime = totalWaitingTime / numProcesses;
-    result.avgResponseTime = totalResponseTime / numProcesses;
+    table = workload;
+    source = nullptr;
+    sink = nullptr;
+    return result;
+}
+
+void Scheduler::recycle(SchedulerResult&& spent) {
+    spare = move(spent);
+}
+
+SchedulerResult Scheduler::simulateRun() {
+    return cpuCount > 1 ? simulateMultiCore(*this) : simulate(*this);
+}
+
+void Scheduler::startInstrumentation() {
+    INSTRUMENT(
+        stats = SchedulerStats();
+        stats.loadSeconds = table->loadSeconds;
+        stats.sortSeconds = table->sortSeconds;
+        scannedEntries = 0;
+        phaseStart = chrono::steady_clock::now();
+    )
+}
+
+SchedulerResult Scheduler::calculateMetrics() {
+    INSTRUMENT(
+        stats.simulateSeconds = secondsSince(phaseStart);
+        stats.scanned = scannedEntries;
+        phaseStart = chrono::steady_clock::now();
+    )
+    // A recycled result brings the capacity of its buffers; its Gantt chart
+    // and per-process columns are already the ones this run filled
+    SchedulerResult result = move(spare);
+    result.ganttChart = move(ganttChart);
+    result.processNames = table->names();
+    ganttChart.clear();
+    
+    // Totals were accumulated as each process completed; an empty workload
+    // averages to 0 rather than NaN
+    size_t numProcesses = completedProcesses;
+    size_t divisor = numProcesses > 0 ? numProcesses : 1;
+    result.avgTurnaroundTime = totalTurnaroundTime / divisor;
+    result.avgWaitingTime = totalWaitingTime / divisor;
+    result.avgResponseTime = totalResponseTime / divisor;
+    // Copies reuse the result's counters, and ours stay allocated for the next run
+    result.turnaroundTimes = turnaroundHistogram;
+    result.waitingTimes = waitingHistogram;
+    result.responseTimes = responseHistogram;
     
     // Calculate throughput (processes per unit time)
     int totalTime = currentTime > 0 ? currentTime : 1; // Avoid division by zero
     result.throughput = static_cast<double>(numProcesses) / totalTime;
     
-    // Calculate CPU utilization
-    int totalBurstTime = 0;
-    for (const auto& process : processes) {
-        totalBurstTime += process.getBurstTime();
+    // Calculate CPU utilization, as a share of all CPUs' time
+    result.cpuUtilization = static_cast<double>(busyTime) / totalTime / cpuCount * 100.0;
+    
+    // Streaming runs reuse rows, so only a whole table has one time per process
+    if (source == nullptr) {
+        result.completions = move(jobs.completion);
+        result.responses = move(jobs.response);
+    } else {
+        result.completions.clear();
+        result.responses.clear();
     }
     
-    result.cpuUtilization = static_cast<double>(totalBurstTime) / totalTime * 100.0;
+    result.steals = steals;
+    if (cpuCount > 1) {
+        result.cpus.resize(cpuCount);
+        for (size_t cpu = 0; cpu < cpuCount; cpu++) {
+            result.cpus[cpu].ganttChart = move(cpuCharts[cpu]);
+            result.cpus[cpu].utilization = static_cast<double>(cpuBusyTime[cpu]) / totalTime * 100.0;
+        }
+    } else {
+        result.cpus.clear();
+    }
     
+    INSTRUMENT(stats.metricsSeconds = secondsSince(phaseStart);)
+    result.stats = stats;
     return result;
 }
 
 void Scheduler::resetProcesses() {
-    for (auto& process : processes) {
-        process.reset();
-    }
-    currentTime = 0;
+    ganttChart.swap(spare.ganttChart);
     ganttChart.clear();
-}
\ No newline at end of file
+    jobs.completion.swap(spare.completions);
+    jobs.response.swap(spare.responses);
+    jobs.reset(*table);
+    currentTime = 0;
+    nextArrival = 0;
+    
+    completedProcesses = 0;
+    totalTurnaroundTime = 0;
+    totalWaitingTime = 0;
+    totalResponseTime = 0;
+    turnaroundHistogram.clear();
+    waitingHistogram.clear();
+    responseHistogram.clear();
+    busyTime = 0;
+    steals = 0;
+}
+
+bool Scheduler::arrivalsPending() const {
+    return source != nullptr ? hasLookahead : nextArrival < table->size();
+}
+
+void Scheduler::pullLookahead() {
+    int previousArrival = hasLookahead ? lookahead.getArrivalTime() : 0;
+    bool wasPending = hasLookahead;
+    
+    hasLookahead = source->next(lookahead);
+    if (hasLookahead && wasPending && lookahead.getArrivalTime() < previousArrival) {
+        throw runtime_error("Arrival source is not sorted by arrival time (process " + 
+                            lookahead.getId() + ")");
+    }
+    if (hasLookahead) {
+        streamWorkEnd = extendWorkEnd(streamWorkEnd, lookahead.getArrivalTime(), lookahead.getBurstTime());
+        if (streamWorkEnd > MAX_WORK_END) {
+            throw runtime_error("Arrival source keeps a CPU busy past time " + to_string(MAX_WORK_END) + 
+                                " (process " + lookahead.getId() + ")");
+        }
+    }
+}
+
+void Scheduler::completeProcess(uint32_t pid) {
+    int turnaroundTime = jobs.completion[pid] - table->arrival[pid];
+    int waitingTime = turnaroundTime - table->burst[pid];
+    totalTurnaroundTime += turnaroundTime;
+    totalWaitingTime += waitingTime;
+    totalResponseTime += jobs.response[pid];
+    turnaroundHistogram.record(turnaroundTime);
+    waitingHistogram.record(waitingTime);
+    responseHistogram.record(jobs.response[pid]);
+    completedProcesses++;
+    
+    if (source == nullptr) {
+        return;
+    }
+    
+    // Hand the process over, then release its row for the next arrival
+    if (sink != nullptr) {
+        CompletedJob job;
+        job.id = liveRows.takeName(pid);
+        job.arrivalTime = table->arrival[pid];
+        job.burstTime = table->burst[pid];
+        job.priority = table->priority[pid];
+        job.completionTime = jobs.completion[pid];
+        job.responseTime = jobs.response[pid];
+        sink->onCompletion(job);
+    }
+    freeSlots.push_back(pid);
+}
+
+int Scheduler::nextArrivalTime() const {
+    if (source != nullptr) {
+        return hasLookahead ? lookahead.getArrivalTime() : numeric_limits<int>::max();
+    }
+    if (nextArrival >= table->size()) {
+        return numeric_limits<int>::max();
+    }
+    return table->arrival[nextArrival];
+}
+
+void Scheduler::recordExecution(size_t cpu, uint32_t pid, int start, int duration) {
+    if (duration <= 0 || source != nullptr) {
+        return;
+    }
+    
+    vector<GanttSegment>& chart = cpuCharts[cpu];
+    if (!chart.empty() && chart.back().end == start && chart.back().pid == pid) {
+        chart.back().end = start + duration;
+        return;
+    }
+    chart.push_back({pid, start, start + duration});
+}
+
+void Scheduler::recordExecution(uint32_t pid, int start, int duration) {
+    // Streaming runs would otherwise grow the chart without bound
+    if (duration <= 0 || source != nullptr) {
+        return;
+    }
+    
+    // Same process continuing without a gap: just stretch its segment
+    if (!ganttChart.empty() && 
+        ganttChart.back().end == start && 
+        ganttChart.back().pid == pid) {
+        ganttChart.back().end = start + duration;
+        return;
+    }
+    
+    ganttChart.push_back({pid, start, start + duration});
+}
+
+void Scheduler::growReadyQueue(size_t /*capacity*/) {}
+
+void Scheduler::requeue(uint32_t pid, size_t queue) {
+    enqueue(pid, queue);
+}
+
+int Scheduler::sliceLength(uint32_t running, size_t /*queue*/) const {
+    return jobs.remaining[running];
+}
+
+bool Scheduler::preemptsOnArrival() const {
+    return false;
+}
+
+bool Scheduler::shouldPreempt(uint32_t /*running*/, size_t /*queue*/) const {
+    return false;
+}
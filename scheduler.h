@@ -4,21 +4,72 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <memory>
 #include "process.h"
+#include "process_table.h"
+#include "arrival_source.h"
+#include "completion_sink.h"
+#include "latency_histogram.h"
+#include "scheduler_stats.h"
+#include "scratch_arena.h"
 
 using namespace std;
 
+/**
+ * @struct GanttSegment
+ * @brief A contiguous interval during which one process (or nothing) held the CPU
+ */
+struct GanttSegment {
+    uint32_t pid;      // Process that ran, or NO_PID while the CPU was idle
+    int start;         // Time at which the interval begins
+    int end;           // Time at which the interval ends (exclusive)
+};
+
+/**
+ * @enum QueueMode
+ * @brief How ready processes are shared between simulated CPUs
+ */
+enum QueueMode {
+    GLOBAL_QUEUE,      // One ready queue that every CPU dispatches from
+    PER_CPU_QUEUES     // One ready queue per CPU; idle CPUs steal from the longest other queue
+};
+
+/**
+ * @struct CpuTrack
+ * @brief Timeline and utilization of one simulated CPU
+ */
+struct CpuTrack {
+    vector<GanttSegment> ganttChart;                     // Segments run on this CPU, idle gaps included
+    double utilization;                                  // Percentage of the run this CPU was busy
+};
+
 /**
  * @struct SchedulerResult
  * @brief Contains the results of a scheduling simulation
  */
 struct SchedulerResult {
-    vector<pair<string, int>> ganttChart;  // Process ID and time slice pairs
+    vector<GanttSegment> ganttChart;                     // One segment per context switch
     double avgTurnaroundTime;                            // Average turnaround time
     double avgWaitingTime;                               // Average waiting time
     double avgResponseTime;                              // Average response time
+    LatencyHistogram turnaroundTimes;                    // Distribution of turnaround times
+    LatencyHistogram waitingTimes;                       // Distribution of waiting times
+    LatencyHistogram responseTimes;                      // Distribution of response times
     double throughput;                                   // Processes per unit time
-    double cpuUtilization;                               // Percentage of CPU utilization
+    double cpuUtilization;                               // Percentage of CPU utilization, averaged over CPUs
+    vector<CpuTrack> cpus;                               // Per-CPU timelines; empty for single-CPU runs
+    vector<int> completions;                             // Completion time of each process by PID; empty for streaming runs
+    vector<int> responses;                               // First dispatch time - arrival time of each process by PID; likewise
+    size_t steals;                                       // Processes an idle CPU took from another CPU's queue
+    SchedulerStats stats;                                // Operation counts and phase timings; zero unless instrumented
+    shared_ptr<const vector<string>> processNames;       // Process names indexed by PID
+    
+    /**
+     * @brief Gets the display name of a Gantt chart PID
+     * @param pid PID from a GanttSegment
+     * @return Process name, or "IDLE" for NO_PID
+     */
+    string nameOf(uint32_t pid) const;
 };
 
 /**
@@ -27,9 +78,55 @@ struct SchedulerResult {
  */
 class Scheduler {
 protected:
-    vector<Process> processes;                      // List of processes to schedule
-    vector<pair<string, int>> ganttChart; // Timeline of process execution
+    const ProcessTable* table;                           // Processes being scheduled: the workload, or liveRows while streaming
+    const ProcessTable* workload;                        // Shared workload run() schedules, never modified
+    ProcessTable ownedTable;                             // Workload built from a process list, empty otherwise
+    JobState jobs;                                       // Per-run state of each process in table
+    vector<GanttSegment> ganttChart;                     // Timeline of process execution
     int currentTime;                                     // Current simulation time
+    size_t nextArrival;                                  // Arrival cursor: first PID not yet admitted
+    
+    // Simulated CPUs
+    size_t cpuCount;                                     // Number of CPUs, at least 1
+    QueueMode queueMode;                                 // Shared or per-CPU ready queues
+    ScratchVector<size_t> queueLength;                   // Processes waiting in each ready queue (multi-CPU only)
+    ScratchVector<size_t> cpuLoad;                       // Waiting plus running processes of each CPU (per-CPU queues only)
+    ScratchVector<long long> cpuBusyTime;                // Time each CPU spent running processes
+    vector<vector<GanttSegment>> cpuCharts;              // Timeline of each CPU (multi-CPU only)
+    size_t steals;                                       // Processes taken from another CPU's queue
+    
+    // Streaming state, only used by runStreaming()
+    ProcessTable liveRows;                               // Rows of the live processes, reused as they complete
+    ArrivalSource* source;                               // Where arrivals come from, or nullptr for the table
+    CompletionSink* sink;                                // Receives completed processes, may be nullptr
+    Process lookahead;                                   // Next process from the source, not yet admitted
+    bool hasLookahead;                                   // Whether lookahead holds a process
+    uint64_t admitted;                                   // Processes admitted so far
+    long long streamWorkEnd;                             // When one CPU would finish the processes pulled so far
+    ScratchVector<uint32_t> freeSlots;                   // Table rows released by completed processes
+    size_t queueCapacity;                                // PIDs the ready queue is sized for
+    
+    // Metrics accumulated as processes complete
+    size_t completedProcesses;                           // Processes completed so far
+    double totalTurnaroundTime;                          // Sum of turnaround times
+    double totalWaitingTime;                             // Sum of waiting times
+    double totalResponseTime;                            // Sum of response times
+    LatencyHistogram turnaroundHistogram;                // Turnaround times for percentiles
+    LatencyHistogram waitingHistogram;                   // Waiting times for percentiles
+    LatencyHistogram responseHistogram;                  // Response times for percentiles
+    long long busyTime;                                  // Time the CPU spent running processes
+    SchedulerResult spare;                               // Result handed to recycle(), whose buffers the next run fills
+    
+    // Instrumentation, only updated in instrumented builds
+    SchedulerStats stats;                                // Counts and timings of the current run
+    chrono::steady_clock::time_point phaseStart;         // When the current phase began
+    
+    /**
+     * @brief Clears the stats and starts timing the simulate phase
+     * 
+     * Does nothing unless the build is instrumented.
+     */
+    void startInstrumentation();
     
     /**
      * @brief Calculates performance metrics after scheduling
@@ -38,27 +135,273 @@ protected:
     SchedulerResult calculateMetrics();
     
     /**
-     * @brief Resets all processes to their initial state
+     * @brief Resets all processes and the simulation clock to their initial state
+     * 
+     * The Gantt chart and per-process columns are written straight into
+     * the buffers of a recycled result, if there is one.
      */
     void resetProcesses();
+    
+    /**
+     * @brief Runs the event loop that suits the number of CPUs
+     * @return SchedulerResult containing all metrics
+     * 
+     * Passes the scheduler itself as the hooks, so they are called
+     * virtually. A final subclass overrides this to pass itself, which lets
+     * the compiler call and inline its hooks directly; the loops are
+     * defined in scheduler_loop.h.
+     */
+    virtual SchedulerResult simulateRun();
+    
+    /**
+     * @brief Runs the shared discrete-event simulation loop
+     * @param hooks Object whose ready-queue hooks the loop calls, this scheduler or its final type
+     * @return SchedulerResult containing all metrics
+     * 
+     * Instead of ticking one time unit at a time, the clock jumps straight to
+     * the next arrival, slice expiry or completion. PIDs are in arrival order
+     * and admitted through a single cursor, so each one is handed to
+     * enqueue() exactly once. Subclasses supply the ready queue through the
+     * hooks below. In streaming mode the same loop admits from the source
+     * instead of the table.
+     */
+    template <typename Hooks>
+    SchedulerResult simulate(Hooks& hooks);
+    
+    /**
+     * @brief Runs the discrete-event loop on several CPUs
+     * @param hooks Object whose ready-queue hooks the loop calls
+     * @return SchedulerResult containing all metrics and per-CPU tracks
+     * 
+     * Each CPU runs one slice at a time; the clock jumps to the earliest
+     * slice end or arrival. At each event, finished slices complete or are
+     * checked for preemption first, then idle CPUs dispatch from their own
+     * queue and, if it is empty, steal from the longest other queue. With
+     * one CPU this makes the same decisions as simulate().
+     */
+    template <typename Hooks>
+    SchedulerResult simulateMultiCore(Hooks& hooks);
+    
+    /**
+     * @brief Gets the number of ready queues subclasses must keep
+     * @return cpuCount with per-CPU queues, otherwise 1
+     */
+    size_t readyQueueCount() const;
+    
+    /**
+     * @brief Adds a newly arrived process to the ready queue chosen for it
+     * @param hooks Object whose enqueue() takes the process
+     * @param pid Process that has just arrived
+     * 
+     * Per-CPU queues place it on the CPU with the fewest waiting and running
+     * processes, the lowest index on ties.
+     */
+    template <typename Hooks>
+    void admit(Hooks& hooks, uint32_t pid);
+    
+    /**
+     * @brief Whether any process has yet to be admitted
+     * @return True while the table cursor or the source has more processes
+     */
+    bool arrivalsPending() const;
+    
+    /**
+     * @brief Admits every process that has arrived by the current time
+     * @param hooks Object whose enqueue() takes the processes
+     * @return Number of processes admitted
+     */
+    template <typename Hooks>
+    size_t admitArrivals(Hooks& hooks);
+    
+    /**
+     * @brief Pulls the next process from the source into the lookahead
+     * 
+     * Throws runtime_error if the source is not sorted by arrival or its
+     * work would run past MAX_WORK_END.
+     */
+    void pullLookahead();
+    
+    /**
+     * @brief Records a completed process in the metrics and, when streaming, releases it
+     * @param pid Process that has just completed
+     */
+    void completeProcess(uint32_t pid);
+    
+    /**
+     * @brief Gets the arrival time of the next process not yet admitted
+     * @return Arrival time, or INT_MAX if every process has arrived
+     */
+    int nextArrivalTime() const;
+    
+    /**
+     * @brief Empties the ready queues and sizes them for PIDs below capacity
+     * @param capacity One past the largest PID that will be enqueued
+     * 
+     * Subclasses keep readyQueueCount() queues, numbered from 0.
+     */
+    virtual void resetReadyQueue(size_t capacity) = 0;
+    
+    /**
+     * @brief Sizes the ready queues for PIDs below capacity, keeping their contents
+     * @param capacity New upper bound on PIDs
+     * 
+     * Called in streaming mode when the number of live processes outgrows
+     * the table. Does nothing by default.
+     */
+    virtual void growReadyQueue(size_t capacity);
+    
+    /**
+     * @brief Appends an execution interval to the Gantt chart
+     * @param pid Process that ran, or NO_PID when the CPU had nothing to run
+     * @param start Time at which the interval begins
+     * @param duration Length of the interval
+     * 
+     * Extends the last segment when the same process keeps the CPU, so the
+     * chart grows with the number of context switches, not with time.
+     */
+    void recordExecution(uint32_t pid, int start, int duration);
+    
+    /**
+     * @brief Appends an execution interval to one CPU's timeline
+     * @param cpu CPU that ran the interval
+     * @param pid Process that ran, or NO_PID when the CPU had nothing to run
+     * @param start Time at which the interval begins
+     * @param duration Length of the interval
+     */
+    void recordExecution(size_t cpu, uint32_t pid, int start, int duration);
+    
+    /**
+     * @brief Adds a newly arrived process to a ready queue
+     * @param pid Process that has just arrived
+     * @param queue Ready queue to add it to
+     */
+    virtual void enqueue(uint32_t pid, size_t queue) = 0;
+    
+    /**
+     * @brief Returns a preempted process to a ready queue
+     * @param pid Process that was taken off the CPU
+     * @param queue Ready queue of the CPU it ran on
+     * 
+     * Defaults to enqueue().
+     */
+    virtual void requeue(uint32_t pid, size_t queue);
+    
+    /**
+     * @brief Removes and returns the next process to dispatch from a ready queue
+     * @param queue Ready queue to take it from
+     * @return Next process, or NO_PID if the ready queue is empty
+     */
+    virtual uint32_t dequeue(size_t queue) = 0;
+    
+    /**
+     * @brief Gets how long the running process may execute before the next decision
+     * @param running Process currently on the CPU
+     * @param queue Ready queue of the CPU it runs on
+     * @return Slice length, at least 1 and at most the remaining time
+     * 
+     * Defaults to the remaining time, i.e. run to completion.
+     */
+    virtual int sliceLength(uint32_t running, size_t queue) const;
+    
+    /**
+     * @brief Whether a slice must end at the next arrival so preemption can be checked
+     * @return True for arrival-preemptive algorithms, false by default
+     */
+    virtual bool preemptsOnArrival() const;
+    
+    /**
+     * @brief Decides at a slice boundary whether the running process gives up the CPU
+     * @param running Process currently on the CPU
+     * @param queue Ready queue of the CPU it runs on
+     * @return True to requeue the running process and dispatch again, false by default
+     */
+    virtual bool shouldPreempt(uint32_t running, size_t queue) const;
 
 public:
     /**
      * @brief Constructor for Scheduler
-     * @param processes List of processes to schedule
+     * @param processes List of processes to schedule, sorted into a table the scheduler owns
      */
     Scheduler(const std::vector<Process>& processes);
     
+    /**
+     * @brief Constructor for Scheduler
+     * @param table Process table to schedule, e.g. loaded from a binary workload file
+     * 
+     * The table is read in place, not copied, so any number of schedulers
+     * can share it; it must outlive the scheduler and stay unchanged.
+     */
+    Scheduler(const ProcessTable& table);
+    
+    // A copy would still point at the original's table
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+    
     /**
      * @brief Virtual destructor
      */
     virtual ~Scheduler() = default;
     
     /**
-     * @brief Pure virtual function to run the scheduling algorithm
+     * @brief Runs the scheduling algorithm over the whole process table
      * @return SchedulerResult containing all metrics
+     * 
+     * Ready queues and per-job state live in the calling thread's
+     * ScratchArena, which is reset at the start of every run, so a thread
+     * runs one simulation at a time. A scheduler run again on a workload of
+     * the same size allocates nothing but its result, and nothing at all
+     * once that result is handed back through recycle().
+     */
+    virtual SchedulerResult run();
+    
+    /**
+     * @brief Runs the scheduling algorithm over processes pulled from a source
+     * @param arrivals Source of processes in non-decreasing arrival order
+     * @param completions Receives each process as it completes, may be nullptr
+     * @return SchedulerResult with aggregate metrics and no Gantt chart
+     * 
+     * Only processes that have arrived and not yet completed are held in
+     * memory: completed rows are handed to the sink and reused, so a trace of
+     * any length runs in memory proportional to its peak backlog. The
+     * workload is left as it was for later run() calls. Throws runtime_error
+     * if the source goes back in time.
+     */
+    SchedulerResult runStreaming(ArrivalSource& arrivals, CompletionSink* completions = nullptr);
+    
+    /**
+     * @brief Hands back a result that is no longer needed, for the next run to fill
+     * @param spent Result whose Gantt charts, per-process columns and histograms are reused
+     * 
+     * Reusing their capacity spares the allocator in loops that run the
+     * same scheduler many times, such as sweeps and benchmarks.
+     */
+    void recycle(SchedulerResult&& spent);
+    
+    /**
+     * @brief Sets the number of simulated CPUs for later runs
+     * @param cpus Number of CPUs, at least 1; throws invalid_argument otherwise
+     * @param mode Whether the CPUs share one ready queue or each have their own
+     * 
+     * Every algorithm applies its policy within each ready queue. With
+     * per-CPU queues an arrival goes to the least loaded CPU, and a CPU
+     * that runs dry takes the next process from the longest other queue.
+     * Per-CPU queues are each sized for the whole table, so memory grows
+     * with CPUs times processes; runStreaming() keeps that bounded by the
+     * backlog.
+     */
+    void setCpus(size_t cpus, QueueMode mode = PER_CPU_QUEUES);
+    
+    /**
+     * @brief Gets the number of simulated CPUs
+     * @return CPU count
+     */
+    size_t getCpuCount() const;
+    
+    /**
+     * @brief Gets how ready processes are shared between CPUs
+     * @return Queue mode
      */
-    virtual SchedulerResult run() = 0;
+    QueueMode getQueueMode() const;
     
     /**
      * @brief Gets the name of the scheduling algorithm
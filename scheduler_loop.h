@@ -0,0 +1,292 @@
+#ifndef SCHEDULER_LOOP_H
+#define SCHEDULER_LOOP_H
+
+#include <algorithm>
+#include <limits>
+#include "scheduler.h"
+
+// The event loops of Scheduler, as templates over the class that supplies
+// the ready-queue hooks. Scheduler passes itself and so calls the hooks
+// virtually; a final subclass can pass itself instead, and the compiler
+// then calls and inlines its hooks directly. Include this header only
+// where simulateRun() is defined.
+
+template <typename Hooks>
+SchedulerResult Scheduler::simulate(Hooks& hooks) {
+    // Reset all processes and simulation time
+    resetProcesses();
+    
+    // Current running process
+    uint32_t currentProcess = NO_PID;
+    
+    // Processes admitted but not yet completed
+    size_t liveProcesses = 0;
+    
+    // Arrival order identifies a process even when streaming reuses its row
+    INSTRUMENT(uint64_t lastProcess = UINT64_MAX;)
+    
+    // Main event loop: every iteration ends on an arrival, slice expiry or completion
+    while (liveProcesses > 0 || arrivalsPending()) {
+        // Admit every process that has arrived by now
+        liveProcesses += admitArrivals(hooks);
+        
+        // Give the policy a chance to take the CPU away at this boundary
+        if (currentProcess != NO_PID && hooks.shouldPreempt(currentProcess, 0)) {
+            hooks.requeue(currentProcess, 0);
+            INSTRUMENT(stats.preemptions++; stats.enqueues++;)
+            currentProcess = NO_PID;
+        }
+        
+        // If no current process, get the next one from ready queue
+        if (currentProcess == NO_PID) {
+            currentProcess = hooks.dequeue(0);
+            INSTRUMENT(stats.dequeues++;)
+            
+            if (currentProcess == NO_PID) {
+                // CPU is idle until the next arrival
+                INSTRUMENT(stats.idlePeriods++;)
+                int nextTime = nextArrivalTime();
+                recordExecution(NO_PID, currentTime, nextTime - currentTime);
+                currentTime = nextTime;
+                continue;
+            }
+            
+            // Set response time if this is the first time process gets CPU
+            if (jobs.response[currentProcess] < 0) {
+                jobs.response[currentProcess] = currentTime - table->arrival[currentProcess];
+            }
+            INSTRUMENT(
+                stats.dispatches++;
+                stats.contextSwitches += table->sequence[currentProcess] != lastProcess;
+                lastProcess = table->sequence[currentProcess];
+            )
+        }
+        
+        // Run until the policy wants a decision, or until the next arrival
+        // if that arrival might preempt the current process
+        int slice = hooks.sliceLength(currentProcess, 0);
+        if (hooks.preemptsOnArrival() && arrivalsPending()) {
+            slice = min(slice, nextArrivalTime() - currentTime);
+        }
+        
+        jobs.remaining[currentProcess] -= slice;
+        recordExecution(currentProcess, currentTime, slice);
+        busyTime += slice;
+        currentTime += slice;
+        
+        // If process is completed
+        if (jobs.remaining[currentProcess] == 0) {
+            jobs.completion[currentProcess] = currentTime;
+            completeProcess(currentProcess);
+            liveProcesses--;
+            currentProcess = NO_PID;
+        }
+    }
+    
+    // Calculate and return metrics
+    return calculateMetrics();
+}
+
+template <typename Hooks>
+SchedulerResult Scheduler::simulateMultiCore(Hooks& hooks) {
+    resetProcesses();
+    size_t queues = readyQueueCount();
+    bool perCpu = queueMode == PER_CPU_QUEUES;
+    renew(queueLength);
+    renew(cpuLoad);
+    renew(cpuBusyTime);
+    queueLength.assign(queues, 0);
+    cpuLoad.assign(cpuCount, 0);
+    cpuBusyTime.assign(cpuCount, 0);
+    
+    // Each CPU's timeline goes into the matching track of a recycled result
+    cpuCharts.resize(cpuCount);
+    for (size_t cpu = 0; cpu < cpuCount; cpu++) {
+        if (cpu < spare.cpus.size()) {
+            cpuCharts[cpu].swap(spare.cpus[cpu].ganttChart);
+        }
+        cpuCharts[cpu].clear();
+    }
+    
+    ScratchVector<uint32_t> running(cpuCount, NO_PID);  // Process on each CPU
+    ScratchVector<int> sliceEnd(cpuCount, 0);           // Time at which each CPU's slice ends
+    size_t waiting = 0;                                 // Processes in all ready queues
+    size_t liveProcesses = 0;
+    INSTRUMENT(
+        ScratchVector<uint64_t> lastRun(cpuCount, UINT64_MAX);  // Arrival order of the process each CPU ran last
+        ScratchVector<char> idle(cpuCount, 0);                  // Whether each CPU is in an idle period
+    )
+    
+    while (liveProcesses > 0 || arrivalsPending()) {
+        // Complete every process whose last slice ends now
+        for (size_t cpu = 0; cpu < cpuCount; cpu++) {
+            uint32_t pid = running[cpu];
+            if (pid != NO_PID && sliceEnd[cpu] == currentTime && jobs.remaining[pid] == 0) {
+                jobs.completion[pid] = currentTime;
+                completeProcess(pid);
+                liveProcesses--;
+                if (perCpu) {
+                    cpuLoad[cpu]--;
+                }
+                running[cpu] = NO_PID;
+            }
+        }
+        
+        size_t arrived = admitArrivals(hooks);
+        liveProcesses += arrived;
+        waiting += arrived;
+        
+        // Every other slice that ends now is a chance to preempt
+        for (size_t cpu = 0; cpu < cpuCount; cpu++) {
+            size_t queue = perCpu ? cpu : 0;
+            uint32_t pid = running[cpu];
+            if (pid != NO_PID && sliceEnd[cpu] == currentTime && hooks.shouldPreempt(pid, queue)) {
+                hooks.requeue(pid, queue);
+                INSTRUMENT(stats.preemptions++; stats.enqueues++;)
+                queueLength[queue]++;
+                waiting++;
+                running[cpu] = NO_PID;
+            }
+        }
+        
+        // Idle CPUs take the next process from their own queue, or steal
+        // one from the longest other queue
+        for (size_t cpu = 0; cpu < cpuCount && waiting > 0; cpu++) {
+            if (running[cpu] != NO_PID) {
+                continue;
+            }
+            
+            size_t queue = perCpu ? cpu : 0;
+            if (queueLength[queue] == 0) {
+                size_t victim = 0;
+                for (size_t other = 1; other < queues; other++) {
+                    if (queueLength[other] > queueLength[victim]) {
+                        victim = other;
+                    }
+                }
+                INSTRUMENT(scannedEntries += queues;)
+                cpuLoad[victim]--;
+                cpuLoad[cpu]++;
+                steals++;
+                queue = victim;
+            }
+            
+            uint32_t pid = hooks.dequeue(queue);
+            queueLength[queue]--;
+            waiting--;
+            if (jobs.response[pid] < 0) {
+                jobs.response[pid] = currentTime - table->arrival[pid];
+            }
+            INSTRUMENT(
+                stats.dequeues++;
+                stats.dispatches++;
+                stats.contextSwitches += table->sequence[pid] != lastRun[cpu];
+                lastRun[cpu] = table->sequence[pid];
+                idle[cpu] = 0;
+            )
+            running[cpu] = pid;
+            sliceEnd[cpu] = currentTime;
+        }
+        
+        // Start a slice on every CPU that has just made a decision, and find
+        // the earliest event after now
+        bool pending = arrivalsPending();
+        int nextArrivalAt = nextArrivalTime();
+        int nextTime = nextArrivalAt;
+        for (size_t cpu = 0; cpu < cpuCount; cpu++) {
+            uint32_t pid = running[cpu];
+            if (pid == NO_PID) {
+                continue;
+            }
+            if (sliceEnd[cpu] == currentTime) {
+                int slice = hooks.sliceLength(pid, perCpu ? cpu : 0);
+                if (hooks.preemptsOnArrival() && pending) {
+                    slice = min(slice, nextArrivalAt - currentTime);
+                }
+                
+                jobs.remaining[pid] -= slice;
+                recordExecution(cpu, pid, currentTime, slice);
+                cpuBusyTime[cpu] += slice;
+                busyTime += slice;
+                sliceEnd[cpu] = currentTime + slice;
+            }
+            nextTime = min(nextTime, sliceEnd[cpu]);
+        }
+        
+        if (nextTime == numeric_limits<int>::max()) {
+            break;
+        }
+        for (size_t cpu = 0; cpu < cpuCount; cpu++) {
+            if (running[cpu] == NO_PID) {
+                recordExecution(cpu, NO_PID, currentTime, nextTime - currentTime);
+                INSTRUMENT(stats.idlePeriods += !idle[cpu]; idle[cpu] = 1;)
+            }
+        }
+        currentTime = nextTime;
+    }
+    
+    return calculateMetrics();
+}
+
+template <typename Hooks>
+size_t Scheduler::admitArrivals(Hooks& hooks) {
+    size_t count = 0;
+    
+    if (source == nullptr) {
+        // PIDs are in arrival order, so the cursor only moves forward
+        const vector<int>& arrival = table->arrival;
+        size_t totalProcesses = table->size();
+        while (nextArrival < totalProcesses && arrival[nextArrival] <= currentTime) {
+            admit(hooks, static_cast<uint32_t>(nextArrival));
+            nextArrival++;
+            count++;
+        }
+        return count;
+    }
+    
+    while (hasLookahead && lookahead.getArrivalTime() <= currentTime) {
+        // Reuse a released row if there is one, otherwise grow the table
+        uint32_t pid;
+        if (!freeSlots.empty()) {
+            pid = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            pid = static_cast<uint32_t>(table->size());
+            if (table->size() >= queueCapacity) {
+                queueCapacity = max<size_t>(16, 2 * queueCapacity);
+                hooks.growReadyQueue(queueCapacity);
+            }
+        }
+        
+        liveRows.setRow(pid, lookahead, admitted++);
+        jobs.resetRow(pid, lookahead.getBurstTime());
+        admit(hooks, pid);
+        count++;
+        pullLookahead();
+    }
+    return count;
+}
+
+template <typename Hooks>
+void Scheduler::admit(Hooks& hooks, uint32_t pid) {
+    INSTRUMENT(stats.enqueues++;)
+    if (cpuCount == 1) {
+        hooks.enqueue(pid, 0);
+        return;
+    }
+    
+    size_t queue = 0;
+    if (queueMode == PER_CPU_QUEUES) {
+        for (size_t cpu = 1; cpu < cpuCount; cpu++) {
+            if (cpuLoad[cpu] < cpuLoad[queue]) {
+                queue = cpu;
+            }
+        }
+        INSTRUMENT(scannedEntries += cpuCount;)
+        cpuLoad[queue]++;
+    }
+    hooks.enqueue(pid, queue);
+    queueLength[queue]++;
+}
+
+#endif // SCHEDULER_LOOP_H
@@ -0,0 +1,63 @@
+#include "scheduler_stats.h"
+#include <iomanip>
+
+thread_local uint64_t scannedEntries = 0;
+
+namespace {
+    // Escapes a string for a JSON string literal
+    string jsonString(const string& text) {
+        string quoted = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                quoted += '\\';
+                quoted += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                static const char HEX[] = "0123456789abcdef";
+                quoted += "\\u00";
+                quoted += HEX[(c >> 4) & 0xF];
+                quoted += HEX[c & 0xF];
+            } else {
+                quoted += c;
+            }
+        }
+        return quoted + "\"";
+    }
+}
+
+SchedulerStats::SchedulerStats()
+#ifdef SCHEDULER_INSTRUMENTATION
+    : enabled(true),
+#else
+    : enabled(false),
+#endif
+      dispatches(0), contextSwitches(0), preemptions(0), idlePeriods(0),
+      enqueues(0), dequeues(0), scanned(0),
+      loadSeconds(0), sortSeconds(0), simulateSeconds(0), metricsSeconds(0) {}
+
+double SchedulerStats::scannedPerDispatch() const {
+    return dispatches > 0 ? static_cast<double>(scanned) / dispatches : 0;
+}
+
+void SchedulerStats::writeJson(ostream& out, const string& algorithm) const {
+    out << "{";
+    if (!algorithm.empty()) {
+        out << "\"algorithm\": " << jsonString(algorithm) << ", ";
+    }
+    out << "\"enabled\": " << (enabled ? "true" : "false")
+        << ", \"counters\": {"
+        << "\"dispatches\": " << dispatches
+        << ", \"context_switches\": " << contextSwitches
+        << ", \"preemptions\": " << preemptions
+        << ", \"idle_periods\": " << idlePeriods
+        << ", \"enqueues\": " << enqueues
+        << ", \"dequeues\": " << dequeues
+        << ", \"scanned\": " << scanned
+        << ", \"scanned_per_dispatch\": " << setprecision(6) << scannedPerDispatch()
+        << "}, \"seconds\": {"
+        << setprecision(9)
+        << "\"load\": " << loadSeconds
+        << ", \"sort\": " << sortSeconds
+        << ", \"simulate\": " << simulateSeconds
+        << ", \"metrics\": " << metricsSeconds
+        << "}}";
+}
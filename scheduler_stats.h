@@ -0,0 +1,87 @@
+#ifndef SCHEDULER_STATS_H
+#define SCHEDULER_STATS_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <chrono>
+
+using namespace std;
+
+/**
+ * @brief Compiles its arguments only in instrumented builds
+ * 
+ * Build with -DSCHEDULER_INSTRUMENTATION (make STATS=1) to count and time
+ * the simulation; otherwise every INSTRUMENT(...) statement disappears and
+ * the hot path is exactly as without instrumentation.
+ */
+#ifdef SCHEDULER_INSTRUMENTATION
+#define INSTRUMENT(...) __VA_ARGS__
+#else
+#define INSTRUMENT(...)
+#endif
+
+/**
+ * @brief Ready-queue entries examined on this thread since the last reset
+ * 
+ * Heaps, trees and bitmaps bump this from deep inside their operations,
+ * where no scheduler is in reach; a run happens on one thread, so the
+ * scheduler reads and clears it around the run.
+ */
+extern thread_local uint64_t scannedEntries;
+
+/**
+ * @brief Gets the wall time elapsed since a point, for phase timings
+ * @param start Point the phase began
+ * @return Seconds since start
+ */
+inline double secondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @struct SchedulerStats
+ * @brief Operation counts and phase timings of one run
+ * 
+ * Every field stays zero unless the build is instrumented.
+ */
+struct SchedulerStats {
+    bool enabled;                // Whether this build was instrumented
+    
+    // Decisions
+    uint64_t dispatches;         // Times a CPU took a process from a ready queue
+    uint64_t contextSwitches;    // Dispatches of a different process than the CPU ran last
+    uint64_t preemptions;        // Running processes put back in a ready queue
+    uint64_t idlePeriods;        // Stretches during which a CPU had nothing to run
+    
+    // Ready-queue work
+    uint64_t enqueues;           // Processes added to a ready queue, arrivals and preemptions
+    uint64_t dequeues;           // Processes removed from a ready queue
+    uint64_t scanned;            // Heap slots, tree nodes, bitmap words and CPUs examined to decide
+    
+    // Wall time per phase, in seconds
+    double loadSeconds;          // Reading the workload into the table
+    double sortSeconds;          // Ordering the table's rows by arrival
+    double simulateSeconds;      // The event loop, ready-queue resets included
+    double metricsSeconds;       // Building the result
+    
+    /**
+     * @brief Constructor for SchedulerStats with every count and time at zero
+     */
+    SchedulerStats();
+    
+    /**
+     * @brief Gets the average number of entries examined per dispatch
+     * @return scanned / dispatches, or 0 before any dispatch
+     */
+    double scannedPerDispatch() const;
+    
+    /**
+     * @brief Writes the stats as one JSON object
+     * @param out Stream to write to
+     * @param algorithm Algorithm name to include, or empty to leave it out
+     */
+    void writeJson(ostream& out, const string& algorithm = "") const;
+};
+
+#endif // SCHEDULER_STATS_H
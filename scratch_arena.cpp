@@ -0,0 +1,55 @@
+#include "scratch_arena.h"
+#include <algorithm>
+#include <new>
+
+const size_t ScratchArena::FIRST_BLOCK;
+
+ScratchArena::ScratchArena() : used(0) {}
+
+ScratchArena::~ScratchArena() {
+    release();
+}
+
+ScratchArena& ScratchArena::local() {
+    static thread_local ScratchArena arena;
+    return arena;
+}
+
+void ScratchArena::addBlock(size_t bytes) {
+    // Doubling keeps the number of blocks a run needs logarithmic
+    size_t size = blocks.empty() ? FIRST_BLOCK : 2 * blocks.back().size;
+    size = max(size, bytes);
+    
+    Block block;
+    block.data = static_cast<char*>(::operator new(size));
+    block.size = size;
+    blocks.push_back(block);
+    used = 0;
+}
+
+void ScratchArena::reset() {
+    if (blocks.size() > 1) {
+        // The last run outgrew the first block; start the next one with
+        // room for all of it in one place
+        size_t total = capacity();
+        release();
+        addBlock(total);
+    }
+    used = 0;
+}
+
+void ScratchArena::release() {
+    for (const Block& block : blocks) {
+        ::operator delete(block.data);
+    }
+    blocks.clear();
+    used = 0;
+}
+
+size_t ScratchArena::capacity() const {
+    size_t total = 0;
+    for (const Block& block : blocks) {
+        total += block.size;
+    }
+    return total;
+}
@@ -0,0 +1,148 @@
+#ifndef SCRATCH_ARENA_H
+#define SCRATCH_ARENA_H
+
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+
+using namespace std;
+
+/**
+ * @class ScratchArena
+ * @brief Per-thread bump allocator for the working memory of scheduler runs
+ * 
+ * Ready queues, heaps and per-job state are carved out of a few large
+ * blocks and never freed one by one; reset() takes everything back in
+ * O(1) at the start of the next run. If a run needed more than one block,
+ * reset() swaps them for a single block of their total size, so once runs
+ * stop growing they allocate nothing at all.
+ * 
+ * Every thread has its own arena, and a run uses the one of the thread it
+ * runs on, so a thread simulates one run at a time. Memory handed out
+ * before a reset belongs to the next run: containers drop it with renew()
+ * before asking for more.
+ */
+class ScratchArena {
+private:
+    static const size_t FIRST_BLOCK = 64 * 1024;  // Bytes in the first block of a thread
+    
+    struct Block {
+        char* data;     // Start of the block, aligned for any scalar type
+        size_t size;    // Bytes in the block
+    };
+    
+    vector<Block> blocks;  // Blocks in the order they were added; the last one is being filled
+    size_t used;           // Bytes taken from the last block
+    
+    void addBlock(size_t bytes);
+
+public:
+    /**
+     * @brief Constructor for an empty ScratchArena
+     */
+    ScratchArena();
+    
+    /**
+     * @brief Frees every block
+     */
+    ~ScratchArena();
+    
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+    
+    /**
+     * @brief Gets the arena of the calling thread
+     * @return Arena, created on first use and freed when the thread ends
+     */
+    static ScratchArena& local();
+    
+    /**
+     * @brief Takes memory from the arena
+     * @param bytes Size of the memory
+     * @param alignment Required alignment, a power of two no larger than a long double's
+     * @return Memory valid until the next reset() or release()
+     */
+    void* allocate(size_t bytes, size_t alignment) {
+        size_t offset = (used + alignment - 1) & ~(alignment - 1);
+        if (blocks.empty() || offset + bytes > blocks.back().size) {
+            addBlock(bytes);
+            offset = 0;
+        }
+        used = offset + bytes;
+        return blocks.back().data + offset;
+    }
+    
+    /**
+     * @brief Takes back all memory handed out, keeping the capacity for the next run
+     */
+    void reset();
+    
+    /**
+     * @brief Frees every block, e.g. after an unusually large run
+     */
+    void release();
+    
+    /**
+     * @brief Gets the number of bytes held from the system
+     * @return Total size of all blocks
+     */
+    size_t capacity() const;
+};
+
+/**
+ * @class ScratchAllocator
+ * @brief Standard allocator that takes memory from the calling thread's ScratchArena
+ * 
+ * deallocate() does nothing; memory only returns to the arena when it is
+ * reset. Elements are never destroyed in the arena's memory, so only
+ * trivially destructible types are allowed.
+ * 
+ * @tparam T Element type
+ */
+template <typename T>
+class ScratchAllocator {
+    static_assert(is_trivially_destructible<T>::value, "Scratch memory is never destroyed");
+
+public:
+    typedef T value_type;
+    
+    ScratchAllocator() {}
+    
+    template <typename U>
+    ScratchAllocator(const ScratchAllocator<U>&) {}
+    
+    T* allocate(size_t count) {
+        return static_cast<T*>(ScratchArena::local().allocate(count * sizeof(T), alignof(T)));
+    }
+    
+    void deallocate(T*, size_t) {}
+};
+
+template <typename T, typename U>
+bool operator==(const ScratchAllocator<T>&, const ScratchAllocator<U>&) {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const ScratchAllocator<T>&, const ScratchAllocator<U>&) {
+    return false;
+}
+
+/**
+ * @brief Vector whose storage lives in the calling thread's ScratchArena
+ */
+template <typename T>
+using ScratchVector = vector<T, ScratchAllocator<T>>;
+
+/**
+ * @brief Empties a scratch vector and forgets its storage without touching it
+ * @param items Vector whose storage may be from before the arena's last reset
+ * 
+ * Its next growth takes fresh memory from the arena.
+ */
+template <typename T>
+void renew(ScratchVector<T>& items) {
+    ScratchVector<T>().swap(items);
+}
+
+#endif // SCRATCH_ARENA_H
@@ -1,44 +1,40 @@
 #ifndef SJF_SCHEDULER_H
 #define SJF_SCHEDULER_H
 
-#include "scheduler.h"
+#include "policy_scheduler.h"
 
 /**
- * @class SJFScheduler
- * @brief Shortest Job First scheduling algorithm implementation
- * 
- * Processes are executed based on their burst time, with the shortest job getting priority.
- * This implementation supports both preemptive and non-preemptive modes.
+ * @struct ShortestRemaining
+ * @brief Key policy for SJF and SRTF: shorter remaining time first
  */
-class SJFScheduler : public Scheduler {
-private:
-    bool preemptive; // Flag to determine if scheduler is preemptive
-
-public:
-    /**
-     * @brief Constructor for SJFScheduler
-     * @param processes List of processes to schedule
-     * @param preemptive Flag to determine if scheduler is preemptive
-     */
-    SJFScheduler(const vector<Process>& processes, bool preemptive = false);
-    
-    /**
-     * @brief Runs the SJF scheduling algorithm
-     * @return SchedulerResult containing all metrics
-     */
-    SchedulerResult run() override;
+struct ShortestRemaining {
+    static const bool FIXED_KEY = false;          // Remaining times shrink as processes run
+    static const bool RUNNING_KEY_GROWS = false;  // The running process only gets shorter
     
-    /**
-     * @brief Gets the name of the scheduling algorithm
-     * @return String name of the algorithm
-     */
-    string getName() const override;
+    static int key(uint32_t pid, const JobState& jobs, const ProcessTable& /*table*/) {
+        return jobs.remaining[pid];
+    }
     
-    /**
-     * @brief Gets the description of the scheduling algorithm
-     * @return String description of the algorithm
-     */
-    string getDescription() const override;
+    static string name(bool preemptive);
+    static string description(bool preemptive);
 };
 
+/**
+ * @brief Ready-queue ordering of SJF and SRTF: shorter remaining time first, then earlier arrival
+ */
+typedef KeyOrder<ShortestRemaining> ShortestRemainingFirst;
+
+/**
+ * @brief Shortest Job First: the shortest waiting job runs to completion
+ */
+typedef PolicyScheduler<ShortestRemaining, NonPreemptive> SJFScheduler;
+
+/**
+ * @brief Shortest Remaining Time First: an arrival with less work left takes the CPU
+ */
+typedef PolicyScheduler<ShortestRemaining, Preemptive> SRTFScheduler;
+
+extern template class PolicyScheduler<ShortestRemaining, NonPreemptive>;
+extern template class PolicyScheduler<ShortestRemaining, Preemptive>;
+
 #endif // SJF_SCHEDULER_H
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+
+#include "process_table.h"
+#include "arrival_source.h"
+#include "completion_sink.h"
+#include "comparison_runner.h"
+#include "workload_generator.h"
+
+using namespace std;
+
+// Checks that Scheduler::runStreaming() simulates exactly what run() does.
+// Every algorithm of the menu runs on seeded generated workloads on one and
+// three CPUs, with both queue modes, once over the whole table and once each
+// streaming from a TableArrivalSource and from a GeneratorArrivalSource
+// that generates the same workload again. The averages, percentiles and
+// steals must match, and the CompletionSink must receive every process
+// exactly once with run()'s completion and response times. Exits with 1 on
+// the first mismatch.
+
+namespace {
+    // Checks every handed-over process against the completions of run()
+    class CheckingSink : public CompletionSink {
+    private:
+        const ProcessTable& table;
+        const SchedulerResult& expected;
+        unordered_map<string, uint32_t> pidOf;
+        vector<bool> seen;
+    
+    public:
+        size_t received;
+        string error;
+        
+        CheckingSink(const ProcessTable& table, const SchedulerResult& expected)
+            : table(table), expected(expected), seen(table.size(), false), received(0) {
+            for (uint32_t pid = 0; pid < table.size(); pid++) {
+                pidOf[table.name(pid)] = pid;
+            }
+        }
+        
+        void onCompletion(const CompletedJob& job) override {
+            received++;
+            if (!error.empty()) {
+                return;
+            }
+            auto found = pidOf.find(job.id);
+            if (found == pidOf.end()) {
+                error = "unknown process " + job.id;
+                return;
+            }
+            uint32_t pid = found->second;
+            if (seen[pid]) {
+                error = job.id + " completed twice";
+            } else if (job.arrivalTime != table.arrival[pid] || job.burstTime != table.burst[pid] ||
+                       job.priority != table.priority[pid]) {
+                error = job.id + " was handed over with the wrong row";
+            } else if (job.completionTime != expected.completions[pid]) {
+                error = job.id + " completed at " + to_string(job.completionTime) + ", run() has " +
+                        to_string(expected.completions[pid]);
+            } else if (job.responseTime != expected.responses[pid]) {
+                error = job.id + " responded after " + to_string(job.responseTime) + ", run() has " +
+                        to_string(expected.responses[pid]);
+            }
+            seen[pid] = true;
+        }
+    };
+    
+    bool fail(const string& test, size_t trial, const string& message) {
+        cerr << "FAIL " << test << " trial " << trial << ": " << message << endl;
+        return false;
+    }
+    
+    // Describes the first difference between two histograms, or returns ""
+    string compareHistograms(const char* name, const LatencyHistogram& expected, const LatencyHistogram& actual) {
+        static const double PERCENTS[] = {50, 90, 99, 99.9, 100};
+        if (actual.count() != expected.count() || actual.max() != expected.max()) {
+            return string(name) + " count or max differs";
+        }
+        for (double percent : PERCENTS) {
+            if (actual.percentile(percent) != expected.percentile(percent)) {
+                return string(name) + " p" + to_string(percent) + " is " + to_string(actual.percentile(percent)) +
+                       ", run() has " + to_string(expected.percentile(percent));
+            }
+        }
+        return "";
+    }
+    
+    // Describes the first metric that differs from run(), or returns ""
+    string compareResults(const SchedulerResult& expected, const SchedulerResult& actual) {
+        if (actual.avgTurnaroundTime != expected.avgTurnaroundTime ||
+            actual.avgWaitingTime != expected.avgWaitingTime ||
+            actual.avgResponseTime != expected.avgResponseTime) {
+            return "averages are " + to_string(actual.avgTurnaroundTime) + "/" + to_string(actual.avgWaitingTime) +
+                   "/" + to_string(actual.avgResponseTime) + ", run() has " +
+                   to_string(expected.avgTurnaroundTime) + "/" + to_string(expected.avgWaitingTime) + "/" +
+                   to_string(expected.avgResponseTime);
+        }
+        if (actual.throughput != expected.throughput || actual.cpuUtilization != expected.cpuUtilization) {
+            return "throughput or utilization differs";
+        }
+        if (actual.steals != expected.steals) {
+            return to_string(actual.steals) + " steals, run() has " + to_string(expected.steals);
+        }
+        string error = compareHistograms("turnaround", expected.turnaroundTimes, actual.turnaroundTimes);
+        if (error.empty()) {
+            error = compareHistograms("waiting", expected.waitingTimes, actual.waitingTimes);
+        }
+        if (error.empty()) {
+            error = compareHistograms("response", expected.responseTimes, actual.responseTimes);
+        }
+        return error;
+    }
+    
+    // Workloads from light to overloaded, with many equal arrival times at
+    // the higher rates so that tie-breaking is exercised
+    WorkloadSpec makeSpec(size_t trial) {
+        WorkloadSpec spec;
+        spec.seed = WorkloadGenerator::streamSeed(2024, trial);
+        spec.jobs = 1 + (trial * 97) % 600;
+        switch (trial % 4) {
+        case 0:
+            spec.arrivalRate = 0.05;
+            break;
+        case 1:
+            spec.arrivalRate = 0.5;
+            spec.priorityWeights = {1, 4, 4, 1};
+            break;
+        case 2:
+            spec.arrivals = MMPP_ARRIVALS;
+            spec.bursts = PARETO_BURSTS;
+            spec.maxBurst = 200;
+            spec.deadlineFraction = 0.3;
+            break;
+        default:
+            spec.arrivalRate = 2.0;
+            spec.bursts = LOGNORMAL_BURSTS;
+            spec.maxBurst = 50;
+            break;
+        }
+        return spec;
+    }
+    
+    bool testStreamingMatchesRun(size_t trials) {
+        static const size_t CPU_COUNTS[] = {1, 3};
+        static const QueueMode QUEUE_MODES[] = {PER_CPU_QUEUES, GLOBAL_QUEUE};
+        
+        for (size_t trial = 0; trial < trials; trial++) {
+            WorkloadSpec spec = makeSpec(trial);
+            ProcessTable table = WorkloadGenerator::generateTable(spec);
+            int timeQuantum = 1 + static_cast<int>(trial % 5);
+            
+            for (const auto& factory : defaultAlgorithms(timeQuantum)) {
+                unique_ptr<Scheduler> scheduler = factory(table);
+                for (size_t cpus : CPU_COUNTS) {
+                    for (QueueMode mode : QUEUE_MODES) {
+                        if (cpus == 1 && mode == GLOBAL_QUEUE) {
+                            continue;
+                        }
+                        scheduler->setCpus(cpus, mode);
+                        string test = scheduler->getName() + " on " + to_string(cpus) + " CPU" +
+                                      (cpus > 1 ? (mode == GLOBAL_QUEUE ? "s, global queue" : "s, per-CPU queues") : "");
+                        SchedulerResult expected = scheduler->run();
+                        
+                        TableArrivalSource tableSource(table);
+                        CheckingSink tableSink(table, expected);
+                        SchedulerResult fromTable = scheduler->runStreaming(tableSource, &tableSink);
+                        string error = compareResults(expected, fromTable);
+                        if (error.empty() && tableSink.received != table.size()) {
+                            error = "sink received " + to_string(tableSink.received) + " of " +
+                                    to_string(table.size()) + " processes";
+                        }
+                        if (error.empty()) {
+                            error = tableSink.error;
+                        }
+                        if (!error.empty()) {
+                            return fail(test + ", table source", trial, error);
+                        }
+                        
+                        WorkloadGenerator generator(spec);
+                        GeneratorArrivalSource generatedSource([&generator](Process& process) {
+                            return generator.next(process);
+                        });
+                        CheckingSink generatedSink(table, expected);
+                        SchedulerResult generated = scheduler->runStreaming(generatedSource, &generatedSink);
+                        error = compareResults(expected, generated);
+                        if (error.empty() && generatedSink.received != table.size()) {
+                            error = "sink received " + to_string(generatedSink.received) + " of " +
+                                    to_string(table.size()) + " processes";
+                        }
+                        if (error.empty()) {
+                            error = generatedSink.error;
+                        }
+                        if (!error.empty()) {
+                            return fail(test + ", generator source", trial, error);
+                        }
+                        
+                        // Streaming leaves the workload for later runs
+                        if (!compareResults(expected, scheduler->run()).empty()) {
+                            return fail(test, trial, "run() after streaming differs");
+                        }
+                    }
+                }
+            }
+        }
+        return true;
+    }
+}
+
+int main() {
+    if (!testStreamingMatchesRun(40)) {
+        return 1;
+    }
+    
+    cout << "runStreaming() matches run() for every algorithm" << endl;
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include "thread_pool.h"
+#include <algorithm>
+#include <utility>
+
+ThreadPool::ThreadPool(size_t threads) : pending(0), stopping(false) {
+    if (threads == 0) {
+        threads = hardwareThreads();
+    }
+    
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    taskReady.notify_all();
+    
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::size() const {
+    return workers.size();
+}
+
+void ThreadPool::submit(function<void()> task) {
+    {
+        lock_guard<mutex> guard(lock);
+        tasks.push(move(task));
+        pending++;
+    }
+    taskReady.notify_one();
+}
+
+void ThreadPool::wait() {
+    unique_lock<mutex> guard(lock);
+    allDone.wait(guard, [this] { return pending == 0; });
+}
+
+namespace {
+    // Indices [begin, end) still owned by one worker
+    struct StealRange {
+        mutex lock;
+        size_t begin;
+        size_t end;
+    };
+    
+    // Takes the next index from the front of a range
+    bool takeFront(StealRange& range, size_t& index) {
+        lock_guard<mutex> guard(range.lock);
+        if (range.begin >= range.end) {
+            return false;
+        }
+        index = range.begin++;
+        return true;
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const function<void(size_t, size_t)>& body) {
+    size_t workerCount = min(workers.size(), count);
+    if (workerCount == 0) {
+        return;
+    }
+    
+    vector<StealRange> ranges(workerCount);
+    for (size_t w = 0; w < workerCount; w++) {
+        ranges[w].begin = count * w / workerCount;
+        ranges[w].end = count * (w + 1) / workerCount;
+    }
+    
+    for (size_t w = 0; w < workerCount; w++) {
+        submit([w, workerCount, &ranges, &body] {
+            StealRange& own = ranges[w];
+            while (true) {
+                size_t index;
+                if (takeFront(own, index)) {
+                    body(index, w);
+                    continue;
+                }
+                
+                // Own range is empty: steal the upper half of the fullest one
+                size_t victim = workerCount;
+                size_t most = 0;
+                for (size_t v = 0; v < workerCount; v++) {
+                    lock_guard<mutex> guard(ranges[v].lock);
+                    size_t left = ranges[v].end - min(ranges[v].begin, ranges[v].end);
+                    if (left > most) {
+                        most = left;
+                        victim = v;
+                    }
+                }
+                if (victim == workerCount) {
+                    return;
+                }
+                
+                size_t stolenBegin;
+                size_t stolenEnd;
+                {
+                    lock_guard<mutex> guard(ranges[victim].lock);
+                    StealRange& range = ranges[victim];
+                    if (range.begin >= range.end) {
+                        continue;
+                    }
+                    size_t middle = range.begin + (range.end - range.begin) / 2;
+                    stolenBegin = middle;
+                    stolenEnd = range.end;
+                    range.end = middle;
+                }
+                {
+                    lock_guard<mutex> guard(own.lock);
+                    own.begin = stolenBegin;
+                    own.end = stolenEnd;
+                }
+            }
+        });
+    }
+    wait();
+}
+
+size_t ThreadPool::hardwareThreads() {
+    unsigned count = thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        function<void()> task;
+        {
+            unique_lock<mutex> guard(lock);
+            taskReady.wait(guard, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = move(tasks.front());
+            tasks.pop();
+        }
+        
+        task();
+        
+        {
+            lock_guard<mutex> guard(lock);
+            pending--;
+            if (pending == 0) {
+                allDone.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads that run submitted tasks
+ * 
+ * Workers are started once and reused, so a batch of short simulations
+ * does not pay for thread creation every time. Tasks must not throw;
+ * callers that can fail catch inside the task and report back.
+ */
+class ThreadPool {
+private:
+    vector<thread> workers;           // Worker threads
+    queue<function<void()>> tasks;    // Tasks waiting for a worker
+    mutex lock;                       // Guards tasks, pending and stopping
+    condition_variable taskReady;     // Signalled when a task is queued or on shutdown
+    condition_variable allDone;       // Signalled when pending drops to zero
+    size_t pending;                   // Tasks queued or running
+    bool stopping;                    // Set by the destructor
+    
+    void workerLoop();
+
+public:
+    /**
+     * @brief Constructor for ThreadPool
+     * @param threads Number of workers, or 0 for one per hardware thread
+     */
+    explicit ThreadPool(size_t threads = 0);
+    
+    /**
+     * @brief Finishes queued tasks and joins the workers
+     */
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    /**
+     * @brief Gets the number of worker threads
+     * @return Worker count
+     */
+    size_t size() const;
+    
+    /**
+     * @brief Queues a task for the next free worker
+     * @param task Task to run
+     */
+    void submit(function<void()> task);
+    
+    /**
+     * @brief Blocks until every submitted task has finished
+     */
+    void wait();
+    
+    /**
+     * @brief Runs body(index, worker) for every index in [0, count) and waits
+     * @param count Number of indices
+     * @param body Called once per index; must not throw
+     * 
+     * Indices start out split into one contiguous range per worker. A worker
+     * that runs out steals the upper half of the largest remaining range, so
+     * uneven run times still keep every core busy. The worker argument is
+     * below size() and never used by two calls at once, so it can index
+     * per-worker scratch state.
+     */
+    void parallelFor(size_t count, const function<void(size_t, size_t)>& body);
+    
+    /**
+     * @brief Gets the number of hardware threads, at least 1
+     * @return Hardware thread count
+     */
+    static size_t hardwareThreads();
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,24 @@
+#include <iostream>
+#include <string>
+
+#include "process_loader.h"
+
+using namespace std;
+
+// Converts a workload between CSV and the binary workload format.
+// The direction follows the input: CSV becomes binary, binary becomes CSV.
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        cerr << "Usage: " << argv[0] << " <input.csv|input.bin> <output>\n";
+        return 2;
+    }
+    
+    try {
+        ProcessLoader::convert(argv[1], argv[2]);
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    
+    return 0;
+}
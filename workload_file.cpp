@@ -0,0 +1,199 @@
+#include "workload_file.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+const uint32_t WorkloadFile::VERSION;
+const uint32_t WorkloadFile::ENDIAN_MARK;
+
+namespace {
+    const char MAGIC[8] = {'C', 'P', 'U', 'S', 'W', 'K', 'L', 'D'};
+    
+    uint64_t alignUp(uint64_t offset) {
+        return (offset + 7) & ~static_cast<uint64_t>(7);
+    }
+    
+    // Checks that [offset, offset + bytes) lies inside the file and is aligned
+    bool sectionFits(uint64_t offset, uint64_t bytes, uint64_t fileSize) {
+        return offset % 8 == 0 && offset <= fileSize && bytes <= fileSize - offset;
+    }
+    
+    static_assert(sizeof(int) == sizeof(int32_t), "ProcessTable columns are written as int32_t");
+    
+    void writeColumn(ofstream& out, const vector<int>& values) {
+        out.write(reinterpret_cast<const char*>(values.data()), 
+                  static_cast<streamsize>(values.size() * sizeof(int32_t)));
+    }
+    
+    void padTo(ofstream& out, uint64_t& position, uint64_t offset) {
+        static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        out.write(zeros, static_cast<streamsize>(offset - position));
+        position = offset;
+    }
+}
+
+WorkloadFile::WorkloadFile(const string& filePath) : file(filePath), header(nullptr) {
+    uint64_t fileSize = file.size();
+    if (fileSize < sizeof(WorkloadFileHeader)) {
+        throw runtime_error(filePath + ": too small to be a workload file");
+    }
+    
+    header = reinterpret_cast<const WorkloadFileHeader*>(file.data());
+    if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw runtime_error(filePath + ": not a workload file");
+    }
+    if (header->byteOrder != ENDIAN_MARK) {
+        throw runtime_error(filePath + ": written with a different byte order");
+    }
+    if (header->version != VERSION) {
+        throw runtime_error(filePath + ": unsupported workload format version " + 
+                            to_string(header->version));
+    }
+    
+    uint64_t count = header->count;
+    uint64_t columnBytes = count * sizeof(int32_t);
+    if (count > fileSize / sizeof(int32_t) ||
+        !sectionFits(header->arrivalOffset, columnBytes, fileSize) ||
+        !sectionFits(header->burstOffset, columnBytes, fileSize) ||
+        !sectionFits(header->priorityOffset, columnBytes, fileSize) ||
+        !sectionFits(header->deadlineOffset, columnBytes, fileSize) ||
+        !sectionFits(header->nameIndexOffset, (count + 1) * sizeof(uint64_t), fileSize) ||
+        header->namesOffset > fileSize || header->nameBytes > fileSize - header->namesOffset) {
+        throw runtime_error(filePath + ": section out of bounds");
+    }
+    
+    const uint64_t* nameOffsets = reinterpret_cast<const uint64_t*>(file.data() + header->nameIndexOffset);
+    if (nameOffsets[0] != 0 || nameOffsets[count] != header->nameBytes) {
+        throw runtime_error(filePath + ": corrupt name index");
+    }
+    
+    // Schedulers count remaining time down to zero
+    const int32_t* arrivals = arrival();
+    const int32_t* bursts = burst();
+    for (uint64_t row = 0; row < count; row++) {
+        if (arrivals[row] < 0 || bursts[row] < 0) {
+            throw runtime_error(filePath + ": negative arrival or burst time at row " + to_string(row));
+        }
+    }
+}
+
+bool WorkloadFile::isWorkloadFile(const string& filePath) {
+    ifstream in(filePath, ios::binary);
+    char magic[sizeof(MAGIC)];
+    return in.read(magic, sizeof(magic)) && memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+WorkloadFileHeader WorkloadFile::makeHeader(uint64_t count, uint64_t nameBytes) {
+    uint64_t columnBytes = count * sizeof(int32_t);
+    
+    WorkloadFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = ENDIAN_MARK;
+    header.count = count;
+    header.nameBytes = nameBytes;
+    header.arrivalOffset = alignUp(sizeof(WorkloadFileHeader));
+    header.burstOffset = alignUp(header.arrivalOffset + columnBytes);
+    header.priorityOffset = alignUp(header.burstOffset + columnBytes);
+    header.deadlineOffset = alignUp(header.priorityOffset + columnBytes);
+    header.nameIndexOffset = alignUp(header.deadlineOffset + columnBytes);
+    header.namesOffset = header.nameIndexOffset + (count + 1) * sizeof(uint64_t);
+    return header;
+}
+
+void WorkloadFile::write(const ProcessTable& table, const string& filePath) {
+    ofstream out(filePath, ios::binary | ios::trunc);
+    if (!out.is_open()) {
+        throw runtime_error("Failed to open file: " + filePath);
+    }
+    
+    uint64_t count = table.size();
+    uint64_t columnBytes = count * sizeof(int32_t);
+    
+    // Name index and blob
+    vector<uint64_t> nameOffsets(count + 1, 0);
+    for (uint64_t pid = 0; pid < count; pid++) {
+        nameOffsets[pid + 1] = nameOffsets[pid] + table.name(static_cast<uint32_t>(pid)).size();
+    }
+    
+    WorkloadFileHeader header = makeHeader(count, nameOffsets[count]);
+    
+    uint64_t position = sizeof(header);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    padTo(out, position, header.arrivalOffset);
+    writeColumn(out, table.arrival);
+    position += columnBytes;
+    padTo(out, position, header.burstOffset);
+    writeColumn(out, table.burst);
+    position += columnBytes;
+    padTo(out, position, header.priorityOffset);
+    writeColumn(out, table.priority);
+    position += columnBytes;
+    padTo(out, position, header.deadlineOffset);
+    writeColumn(out, table.deadline);
+    position += columnBytes;
+    padTo(out, position, header.nameIndexOffset);
+    out.write(reinterpret_cast<const char*>(nameOffsets.data()), 
+              static_cast<streamsize>(nameOffsets.size() * sizeof(uint64_t)));
+    for (uint64_t pid = 0; pid < count; pid++) {
+        const string& name = table.name(static_cast<uint32_t>(pid));
+        out.write(name.data(), static_cast<streamsize>(name.size()));
+    }
+    
+    if (!out) {
+        throw runtime_error("Failed to write file: " + filePath);
+    }
+}
+
+const int32_t* WorkloadFile::column(uint64_t offset) const {
+    return reinterpret_cast<const int32_t*>(file.data() + offset);
+}
+
+size_t WorkloadFile::size() const {
+    return static_cast<size_t>(header->count);
+}
+
+const int32_t* WorkloadFile::arrival() const {
+    return column(header->arrivalOffset);
+}
+
+const int32_t* WorkloadFile::burst() const {
+    return column(header->burstOffset);
+}
+
+const int32_t* WorkloadFile::priority() const {
+    return column(header->priorityOffset);
+}
+
+const int32_t* WorkloadFile::deadline() const {
+    return column(header->deadlineOffset);
+}
+
+string WorkloadFile::name(size_t pid) const {
+    const uint64_t* nameOffsets = reinterpret_cast<const uint64_t*>(file.data() + header->nameIndexOffset);
+    const char* names = file.data() + header->namesOffset;
+    uint64_t begin = nameOffsets[pid];
+    uint64_t end = nameOffsets[pid + 1];
+    if (begin > end || end > header->nameBytes) {
+        throw runtime_error("Corrupt name index at row " + to_string(pid));
+    }
+    return string(names + begin, names + end);
+}
+
+ProcessTable WorkloadFile::toTable() const {
+    size_t count = size();
+    vector<string> names;
+    names.reserve(count);
+    for (size_t pid = 0; pid < count; pid++) {
+        names.push_back(name(pid));
+    }
+    
+    // Columns are copied wholesale straight out of the mapping
+    return ProcessTable(vector<int>(arrival(), arrival() + count), 
+                        vector<int>(burst(), burst() + count), 
+                        vector<int>(priority(), priority() + count), 
+                        vector<int>(deadline(), deadline() + count), 
+                        move(names));
+}
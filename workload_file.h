@@ -0,0 +1,105 @@
+#ifndef WORKLOAD_FILE_H
+#define WORKLOAD_FILE_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "mapped_file.h"
+#include "process_table.h"
+
+using namespace std;
+
+/**
+ * @struct WorkloadFileHeader
+ * @brief Fixed header at the start of a binary workload file
+ * 
+ * Layout (native byte order, every section 8-byte aligned):
+ *   header | arrival[count] | burst[count] | priority[count] |
+ *   deadline[count] | nameOffsets[count + 1] | names[nameBytes]
+ * 
+ * Columns are int32_t and rows are sorted by arrival time, so row i is
+ * PID i of a ProcessTable. nameOffsets are uint64_t positions into the
+ * names blob; name i spans [nameOffsets[i], nameOffsets[i + 1]).
+ */
+struct WorkloadFileHeader {
+    char magic[8];             // "CPUSWKLD"
+    uint32_t version;          // Format version, currently 1
+    uint32_t byteOrder;        // 0x01020304 as written by the producing machine
+    uint64_t count;            // Number of processes
+    uint64_t nameBytes;        // Size of the names blob
+    uint64_t arrivalOffset;    // File offset of the arrival column
+    uint64_t burstOffset;      // File offset of the burst column
+    uint64_t priorityOffset;   // File offset of the priority column
+    uint64_t deadlineOffset;   // File offset of the deadline column
+    uint64_t nameIndexOffset;  // File offset of nameOffsets
+    uint64_t namesOffset;      // File offset of the names blob
+};
+
+/**
+ * @class WorkloadFile
+ * @brief Memory-mapped, read-only view of a binary workload file
+ * 
+ * Columns are used in place from the mapping; nothing is parsed. The
+ * constructor validates the header and section bounds and throws
+ * runtime_error if the file is not a well-formed workload.
+ */
+class WorkloadFile {
+private:
+    MappedFile file;                  // Mapping of the whole file
+    const WorkloadFileHeader* header; // Header at the start of the mapping
+
+    const int32_t* column(uint64_t offset) const;
+
+public:
+    static const uint32_t VERSION = 1;
+    static const uint32_t ENDIAN_MARK = 0x01020304;
+
+    /**
+     * @brief Maps and validates a binary workload file
+     * @param filePath Path to the file
+     */
+    explicit WorkloadFile(const string& filePath);
+
+    /**
+     * @brief Checks whether a file starts with the binary workload magic
+     * @param filePath Path to the file
+     * @return True if the file looks like a binary workload
+     */
+    static bool isWorkloadFile(const string& filePath);
+
+    /**
+     * @brief Lays out the header of a file with the given section sizes
+     * @param count Number of processes
+     * @param nameBytes Total length of all names
+     * @return Header with every offset filled in
+     */
+    static WorkloadFileHeader makeHeader(uint64_t count, uint64_t nameBytes);
+
+    /**
+     * @brief Writes a process table in the binary workload format
+     * @param table Table to write
+     * @param filePath Path of the file to create
+     */
+    static void write(const ProcessTable& table, const string& filePath);
+
+    size_t size() const;
+    const int32_t* arrival() const;
+    const int32_t* burst() const;
+    const int32_t* priority() const;
+    const int32_t* deadline() const;
+
+    /**
+     * @brief Gets the name of a process
+     * @param pid Row index
+     * @return Name bytes copied into a string
+     */
+    string name(size_t pid) const;
+
+    /**
+     * @brief Builds a process table from the mapped columns
+     * @return Table whose PIDs are the file's rows
+     */
+    ProcessTable toTable() const;
+};
+
+#endif // WORKLOAD_FILE_H
@@ -0,0 +1,80 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <stdexcept>
+
+#include "workload_generator.h"
+
+using namespace std;
+
+// Generates a synthetic workload and streams it to a CSV or binary file.
+// The format follows the output extension (.bin is binary) unless --format
+// is given. Returns 0 on success, 1 on a failed write and 2 on a usage error.
+
+void printUsage(const char* program) {
+    cerr << "Usage: " << program << " --output <file.csv|file.bin> [options]\n";
+    WorkloadSpec::printOptions(cerr);
+    cerr << "  --format csv|binary       Output format (default from the extension)\n";
+}
+
+int main(int argc, char* argv[]) {
+    WorkloadSpec spec;
+    string output;
+    string format;
+    
+    try {
+        for (int i = 1; i < argc; i++) {
+            string option = argv[i];
+            if (option == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            }
+            if (i + 1 >= argc) {
+                throw invalid_argument("Missing value for " + option);
+            }
+            string value = argv[++i];
+            
+            if (option == "--output") {
+                output = value;
+            } else if (option == "--format") {
+                format = value;
+            } else if (!spec.parseOption(option, value)) {
+                throw invalid_argument("Unknown option " + option);
+            }
+        }
+        
+        if (output.empty()) {
+            throw invalid_argument("--output is required");
+        }
+        if (format.empty()) {
+            bool binaryExtension = output.size() >= 4 && output.compare(output.size() - 4, 4, ".bin") == 0;
+            format = binaryExtension ? "binary" : "csv";
+        }
+        if (format != "csv" && format != "binary") {
+            throw invalid_argument("Unknown format " + format);
+        }
+        spec.validate();
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n";
+        printUsage(argv[0]);
+        return 2;
+    }
+    
+    try {
+        auto start = chrono::steady_clock::now();
+        if (format == "binary") {
+            WorkloadGenerator::writeBinary(spec, output);
+        } else {
+            WorkloadGenerator::writeCsv(spec, output);
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "Generated " << spec.jobs << " processes into " << output << " in "
+             << seconds << " s\n";
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    
+    return 0;
+}
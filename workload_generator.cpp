@@ -0,0 +1,562 @@
+#include "workload_generator.h"
+#include "workload_file.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    const double INT_LIMIT = static_cast<double>(numeric_limits<int>::max());
+    
+    uint64_t splitMix(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    
+    uint64_t rotateLeft(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+    
+    // Rounds up and clamps into [low, high]
+    int ceilClamp(double value, int low, int high) {
+        if (!(value < high)) {
+            return high;
+        }
+        return max(low, static_cast<int>(ceil(value)));
+    }
+    
+    // Appends the decimal digits of a value; returns the new end
+    char* appendInt(char* out, long long value) {
+        if (value < 0) {
+            *out++ = '-';
+            value = -value;
+        }
+        char digits[20];
+        int length = 0;
+        do {
+            digits[length++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        while (length > 0) {
+            *out++ = digits[--length];
+        }
+        return out;
+    }
+    
+    // Total length of the names P1 .. Pn
+    uint64_t nameBytesFor(uint64_t count) {
+        uint64_t bytes = 0;
+        uint64_t digits = 1;
+        for (uint64_t low = 1; low <= count; low *= 10, digits++) {
+            uint64_t high = min(count, low * 10 - 1);
+            bytes += (high - low + 1) * (1 + digits);
+        }
+        return bytes;
+    }
+    
+    invalid_argument badValue(const string& option, const string& text) {
+        return invalid_argument("Invalid value '" + text + "' for " + option);
+    }
+    
+    // The sto* functions stop at the first character they cannot use, so
+    // each of these also checks that the whole text was read
+    double parseDouble(const string& option, const string& text) {
+        size_t used = 0;
+        double value = 0;
+        try {
+            value = stod(text, &used);
+        } catch (const logic_error&) {
+            throw badValue(option, text);
+        }
+        if (used != text.size()) {
+            throw badValue(option, text);
+        }
+        return value;
+    }
+    
+    int parseInt(const string& option, const string& text) {
+        size_t used = 0;
+        int value = 0;
+        try {
+            value = stoi(text, &used);
+        } catch (const logic_error&) {
+            throw badValue(option, text);
+        }
+        if (used != text.size()) {
+            throw badValue(option, text);
+        }
+        return value;
+    }
+    
+    // stoull would accept a minus sign and wrap the value around
+    uint64_t parseUnsigned(const string& option, const string& text) {
+        if (text.empty() || text[0] < '0' || text[0] > '9') {
+            throw badValue(option, text);
+        }
+        size_t used = 0;
+        uint64_t value = 0;
+        try {
+            value = stoull(text, &used);
+        } catch (const logic_error&) {
+            throw badValue(option, text);
+        }
+        if (used != text.size()) {
+            throw badValue(option, text);
+        }
+        return value;
+    }
+    
+    // Accepts forms such as 1e6; converting a negative, fractional or
+    // out-of-range double to uint64_t would be undefined
+    uint64_t parseCount(const string& option, const string& text) {
+        double value = parseDouble(option, text);
+        if (!(value >= 0 && value < 18446744073709551616.0) || value != floor(value)) {
+            throw invalid_argument(option + " must be a whole number of 0 or more, not '" + text + "'");
+        }
+        return static_cast<uint64_t>(value);
+    }
+    
+    vector<double> parseNumbers(const string& option, const string& text, char separator) {
+        vector<double> values;
+        stringstream stream(text);
+        string item;
+        while (getline(stream, item, separator)) {
+            values.push_back(parseDouble(option, item));
+        }
+        return values;
+    }
+    
+    void writeAt(ofstream& out, uint64_t offset, const void* data, size_t bytes) {
+        out.seekp(static_cast<streamoff>(offset));
+        out.write(static_cast<const char*>(data), static_cast<streamsize>(bytes));
+    }
+}
+
+WorkloadSpec::WorkloadSpec()
+    : jobs(1000), seed(1), arrivals(POISSON_ARRIVALS), arrivalRate(0.09), burstArrivalRate(0.9),
+      meanCalmTime(1000), meanBurstyTime(100), bursts(UNIFORM_BURSTS), minBurst(1), maxBurst(19),
+      paretoShape(1.5), lognormalMu(2.0), lognormalSigma(1.0), priorityWeights(10, 1.0),
+      deadlineFraction(0), minDeadlineSlack(1.5), maxDeadlineSlack(4.0) {}
+
+void WorkloadSpec::validate() const {
+    if (!(arrivalRate > 0)) {
+        throw invalid_argument("Arrival rate must be positive");
+    }
+    if (arrivals == MMPP_ARRIVALS &&
+        (!(burstArrivalRate > 0) || !(meanCalmTime > 0) || !(meanBurstyTime > 0))) {
+        throw invalid_argument("MMPP rates and state times must be positive");
+    }
+    if (minBurst < 1 || maxBurst < minBurst) {
+        throw invalid_argument("Burst bounds must satisfy 1 <= minBurst <= maxBurst");
+    }
+    if (bursts == PARETO_BURSTS && !(paretoShape > 0)) {
+        throw invalid_argument("Pareto shape must be positive");
+    }
+    if (bursts == LOGNORMAL_BURSTS && !(lognormalSigma >= 0)) {
+        throw invalid_argument("Lognormal sigma must not be negative");
+    }
+    double totalWeight = 0;
+    for (double weight : priorityWeights) {
+        if (!(weight >= 0)) {
+            throw invalid_argument("Priority weights must not be negative");
+        }
+        totalWeight += weight;
+    }
+    if (!priorityWeights.empty() && !(totalWeight > 0)) {
+        throw invalid_argument("Priority weights must not all be zero");
+    }
+    if (!(deadlineFraction >= 0 && deadlineFraction <= 1)) {
+        throw invalid_argument("Deadline fraction must be between 0 and 1");
+    }
+    if (!(minDeadlineSlack >= 1 && maxDeadlineSlack >= minDeadlineSlack)) {
+        throw invalid_argument("Deadline slack must satisfy 1 <= min <= max");
+    }
+}
+
+bool WorkloadSpec::parseOption(const string& option, const string& value) {
+    if (option == "--jobs") {
+        jobs = parseCount(option, value);
+    } else if (option == "--seed") {
+        seed = parseUnsigned(option, value);
+    } else if (option == "--arrivals") {
+        if (value == "poisson") {
+            arrivals = POISSON_ARRIVALS;
+        } else if (value == "mmpp") {
+            arrivals = MMPP_ARRIVALS;
+        } else {
+            throw invalid_argument("Unknown arrival process " + value);
+        }
+    } else if (option == "--rate") {
+        arrivalRate = parseDouble(option, value);
+    } else if (option == "--burst-rate") {
+        burstArrivalRate = parseDouble(option, value);
+    } else if (option == "--calm-time") {
+        meanCalmTime = parseDouble(option, value);
+    } else if (option == "--bursty-time") {
+        meanBurstyTime = parseDouble(option, value);
+    } else if (option == "--bursts") {
+        if (value == "uniform") {
+            bursts = UNIFORM_BURSTS;
+        } else if (value == "pareto") {
+            bursts = PARETO_BURSTS;
+        } else if (value == "lognormal") {
+            bursts = LOGNORMAL_BURSTS;
+        } else {
+            throw invalid_argument("Unknown burst distribution " + value);
+        }
+    } else if (option == "--min-burst") {
+        minBurst = parseInt(option, value);
+    } else if (option == "--max-burst") {
+        maxBurst = parseInt(option, value);
+    } else if (option == "--pareto-shape") {
+        paretoShape = parseDouble(option, value);
+    } else if (option == "--lognormal-mu") {
+        lognormalMu = parseDouble(option, value);
+    } else if (option == "--lognormal-sigma") {
+        lognormalSigma = parseDouble(option, value);
+    } else if (option == "--priorities") {
+        priorityWeights = parseNumbers(option, value, ',');
+    } else if (option == "--deadline-fraction") {
+        deadlineFraction = parseDouble(option, value);
+    } else if (option == "--deadline-slack") {
+        vector<double> slack = parseNumbers(option, value, ':');
+        if (slack.size() != 2) {
+            throw invalid_argument("--deadline-slack takes MIN:MAX");
+        }
+        minDeadlineSlack = slack[0];
+        maxDeadlineSlack = slack[1];
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void WorkloadSpec::printOptions(ostream& out) {
+    out << "  --jobs N                  Number of processes (default 1000)\n"
+        << "  --seed N                  Random seed (default 1)\n"
+        << "  --arrivals poisson|mmpp   Arrival process (default poisson)\n"
+        << "  --rate R                  Arrival rate, or the MMPP calm-state rate (default 0.09)\n"
+        << "  --burst-rate R            MMPP bursty-state rate (default 0.9)\n"
+        << "  --calm-time T             MMPP mean calm period (default 1000)\n"
+        << "  --bursty-time T           MMPP mean bursty period (default 100)\n"
+        << "  --bursts uniform|pareto|lognormal\n"
+        << "                            Burst time distribution (default uniform)\n"
+        << "  --min-burst N             Uniform minimum and Pareto scale (default 1)\n"
+        << "  --max-burst N             Largest burst time (default 19)\n"
+        << "  --pareto-shape A          Pareto tail index (default 1.5)\n"
+        << "  --lognormal-mu M          Lognormal location (default 2.0)\n"
+        << "  --lognormal-sigma S       Lognormal scale (default 1.0)\n"
+        << "  --priorities W0,W1,...    Relative weight of each priority level (default 10 equal)\n"
+        << "  --deadline-fraction F     Share of processes with a deadline (default 0)\n"
+        << "  --deadline-slack MIN:MAX  Deadline = arrival + burst * slack (default 1.5:4)\n";
+}
+
+WorkloadGenerator::WorkloadGenerator(const WorkloadSpec& spec)
+    : spec(spec), produced(0), clock(0), workEnd(0), bursty(false), stateEnd(0) {
+    spec.validate();
+    
+    uint64_t seed = spec.seed;
+    for (auto& word : state) {
+        word = splitMix(seed);
+    }
+    
+    // Walker's alias table: level i is kept when the low 32 bits of a draw
+    // fall under its threshold and otherwise replaced by its alias, so a
+    // priority costs one random number whatever the number of levels
+    size_t levels = spec.priorityWeights.size();
+    double total = 0;
+    for (double weight : spec.priorityWeights) {
+        total += weight;
+    }
+    vector<double> scaled(levels);
+    vector<size_t> small;
+    vector<size_t> large;
+    for (size_t i = 0; i < levels; i++) {
+        scaled[i] = spec.priorityWeights[i] * levels / total;
+        (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+    priorityThreshold.assign(levels, uint64_t(1) << 32);
+    priorityAlias.resize(levels);
+    for (size_t i = 0; i < levels; i++) {
+        priorityAlias[i] = static_cast<int>(i);
+    }
+    while (!small.empty() && !large.empty()) {
+        size_t low = small.back();
+        size_t high = large.back();
+        small.pop_back();
+        priorityThreshold[low] = static_cast<uint64_t>(scaled[low] * 4294967296.0);
+        priorityAlias[low] = static_cast<int>(high);
+        scaled[high] -= 1.0 - scaled[low];
+        if (scaled[high] < 1.0) {
+            large.pop_back();
+            small.push_back(high);
+        }
+    }
+    
+    if (spec.arrivals == MMPP_ARRIVALS) {
+        stateEnd = exponential(1.0 / spec.meanCalmTime);
+    }
+}
+
+uint64_t WorkloadGenerator::nextRandom() {
+    // xoshiro256**
+    uint64_t result = rotateLeft(state[1] * 5, 7) * 9;
+    uint64_t shifted = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= shifted;
+    state[3] = rotateLeft(state[3], 45);
+    return result;
+}
+
+double WorkloadGenerator::uniform() {
+    // 53 random bits in [0, 1)
+    return static_cast<double>(nextRandom() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double WorkloadGenerator::exponential(double rate) {
+    return -log(1.0 - uniform()) / rate;
+}
+
+double WorkloadGenerator::normal() {
+    // Box-Muller; one of the pair is enough
+    static const double TWO_PI = 6.283185307179586;
+    double radius = sqrt(-2.0 * log(1.0 - uniform()));
+    return radius * cos(TWO_PI * uniform());
+}
+
+void WorkloadGenerator::advanceClock() {
+    if (spec.arrivals == POISSON_ARRIVALS) {
+        clock += exponential(spec.arrivalRate);
+        return;
+    }
+    
+    // Gaps are memoryless, so a gap that runs past a state change is
+    // simply redrawn at the new state's rate
+    while (true) {
+        double gap = exponential(bursty ? spec.burstArrivalRate : spec.arrivalRate);
+        if (clock + gap <= stateEnd) {
+            clock += gap;
+            return;
+        }
+        clock = stateEnd;
+        bursty = !bursty;
+        stateEnd = clock + exponential(1.0 / (bursty ? spec.meanBurstyTime : spec.meanCalmTime));
+    }
+}
+
+int WorkloadGenerator::drawBurst() {
+    switch (spec.bursts) {
+        case PARETO_BURSTS:
+            return ceilClamp(spec.minBurst * pow(1.0 - uniform(), -1.0 / spec.paretoShape),
+                             1, spec.maxBurst);
+        case LOGNORMAL_BURSTS:
+            return ceilClamp(exp(spec.lognormalMu + spec.lognormalSigma * normal()),
+                             1, spec.maxBurst);
+        default: {
+            uint64_t span = static_cast<uint64_t>(spec.maxBurst - spec.minBurst) + 1;
+            return spec.minBurst + static_cast<int>(((nextRandom() >> 32) * span) >> 32);
+        }
+    }
+}
+
+int WorkloadGenerator::drawPriority() {
+    if (priorityAlias.size() <= 1) {
+        return 0;
+    }
+    uint64_t draw = nextRandom();
+    size_t level = static_cast<size_t>(((draw >> 32) * priorityAlias.size()) >> 32);
+    return (draw & 0xFFFFFFFFULL) < priorityThreshold[level] ? static_cast<int>(level) : priorityAlias[level];
+}
+
+bool WorkloadGenerator::nextRow(int& arrival, int& burst, int& priority, int& deadline) {
+    if (produced >= spec.jobs) {
+        return false;
+    }
+    if (clock > INT_LIMIT) {
+        throw runtime_error("Generated arrival times exceed the int range after " +
+                            to_string(produced) + " processes");
+    }
+    
+    arrival = static_cast<int>(clock);
+    burst = drawBurst();
+    
+    // Schedulers would overflow their clocks running past this
+    workEnd = extendWorkEnd(workEnd, arrival, burst);
+    if (workEnd > MAX_WORK_END) {
+        throw runtime_error("Generated work keeps a CPU busy past time " + to_string(MAX_WORK_END) +
+                            " after " + to_string(produced) + " processes");
+    }
+    priority = drawPriority();
+    deadline = 0;
+    if (spec.deadlineFraction > 0 && uniform() < spec.deadlineFraction) {
+        double slack = spec.minDeadlineSlack + (spec.maxDeadlineSlack - spec.minDeadlineSlack) * uniform();
+        deadline = ceilClamp(arrival + burst * slack, 1, numeric_limits<int>::max());
+    }
+    
+    produced++;
+    advanceClock();
+    return true;
+}
+
+bool WorkloadGenerator::next(Process& process) {
+    int arrival;
+    int burst;
+    int priority;
+    int deadline;
+    if (!nextRow(arrival, burst, priority, deadline)) {
+        return false;
+    }
+    process = Process("P" + to_string(produced), arrival, burst, priority, deadline);
+    return true;
+}
+
+uint64_t WorkloadGenerator::count() const {
+    return produced;
+}
+
+ProcessTable WorkloadGenerator::generateTable(const WorkloadSpec& spec) {
+    INSTRUMENT(auto started = chrono::steady_clock::now();)
+    WorkloadGenerator generator(spec);
+    size_t count = static_cast<size_t>(spec.jobs);
+    
+    vector<int> arrival(count);
+    vector<int> burst(count);
+    vector<int> priority(count);
+    vector<int> deadline(count);
+    vector<string> names(count);
+    for (size_t i = 0; i < count; i++) {
+        generator.nextRow(arrival[i], burst[i], priority[i], deadline[i]);
+        names[i] = "P" + to_string(i + 1);
+    }
+    ProcessTable table(move(arrival), move(burst), move(priority), move(deadline), move(names));
+    INSTRUMENT(table.loadSeconds = secondsSince(started) - table.sortSeconds;)
+    return table;
+}
+
+uint64_t WorkloadGenerator::streamSeed(uint64_t seed, uint64_t stream) {
+    // Hashing both keeps nearby seeds and stream numbers from giving
+    // overlapping splitmix sequences
+    uint64_t key = seed;
+    uint64_t mixed = splitMix(key) ^ stream;
+    return splitMix(mixed);
+}
+
+void WorkloadGenerator::writeCsv(const WorkloadSpec& spec, const string& filePath) {
+    static const size_t FLUSH_BYTES = 1 << 20;
+    static const size_t MAX_ROW_BYTES = 96;
+    
+    WorkloadGenerator generator(spec);
+    ofstream out(filePath, ios::binary | ios::trunc);
+    if (!out.is_open()) {
+        throw runtime_error("Failed to open file: " + filePath);
+    }
+    
+    // Rows are formatted by hand into one buffer that is written in blocks
+    vector<char> buffer(FLUSH_BYTES + MAX_ROW_BYTES);
+    static const string HEADER_LINE = "ID,ArrivalTime,BurstTime,Priority,Deadline\n";
+    char* end = copy(HEADER_LINE.begin(), HEADER_LINE.end(), buffer.data());
+    
+    int arrival;
+    int burst;
+    int priority;
+    int deadline;
+    while (generator.nextRow(arrival, burst, priority, deadline)) {
+        *end++ = 'P';
+        end = appendInt(end, static_cast<long long>(generator.count()));
+        *end++ = ',';
+        end = appendInt(end, arrival);
+        *end++ = ',';
+        end = appendInt(end, burst);
+        *end++ = ',';
+        end = appendInt(end, priority);
+        *end++ = ',';
+        end = appendInt(end, deadline);
+        *end++ = '\n';
+        
+        if (static_cast<size_t>(end - buffer.data()) >= FLUSH_BYTES) {
+            out.write(buffer.data(), end - buffer.data());
+            end = buffer.data();
+        }
+    }
+    out.write(buffer.data(), end - buffer.data());
+    
+    if (!out) {
+        throw runtime_error("Failed to write file: " + filePath);
+    }
+}
+
+void WorkloadGenerator::writeBinary(const WorkloadSpec& spec, const string& filePath) {
+    static const size_t CHUNK = 1 << 16;
+    
+    WorkloadGenerator generator(spec);
+    ofstream out(filePath, ios::binary | ios::trunc);
+    if (!out.is_open()) {
+        throw runtime_error("Failed to open file: " + filePath);
+    }
+    
+    uint64_t count = spec.jobs;
+    WorkloadFileHeader header = WorkloadFile::makeHeader(count, nameBytesFor(count));
+    writeAt(out, 0, &header, sizeof(header));
+    
+    // One chunk of every section at a time, each written where it belongs
+    vector<int32_t> arrival(CHUNK);
+    vector<int32_t> burst(CHUNK);
+    vector<int32_t> priority(CHUNK);
+    vector<int32_t> deadline(CHUNK);
+    vector<uint64_t> nameOffsets(CHUNK + 1);
+    vector<char> names;
+    names.reserve(CHUNK * 21);
+    
+    uint64_t row = 0;
+    uint64_t nameEnd = 0;
+    nameOffsets[0] = 0;
+    writeAt(out, header.nameIndexOffset, &nameOffsets[0], sizeof(uint64_t));
+    
+    while (row < count) {
+        size_t rows = static_cast<size_t>(min<uint64_t>(CHUNK, count - row));
+        uint64_t nameStart = nameEnd;
+        names.clear();
+        
+        for (size_t i = 0; i < rows; i++) {
+            int a;
+            int b;
+            int p;
+            int d;
+            generator.nextRow(a, b, p, d);
+            arrival[i] = a;
+            burst[i] = b;
+            priority[i] = p;
+            deadline[i] = d;
+            
+            char name[24];
+            name[0] = 'P';
+            char* nameStop = appendInt(name + 1, static_cast<long long>(row + i + 1));
+            names.insert(names.end(), name, nameStop);
+            nameEnd += nameStop - name;
+            nameOffsets[i] = nameEnd;
+        }
+        
+        uint64_t columnOffset = row * sizeof(int32_t);
+        size_t columnBytes = rows * sizeof(int32_t);
+        writeAt(out, header.arrivalOffset + columnOffset, arrival.data(), columnBytes);
+        writeAt(out, header.burstOffset + columnOffset, burst.data(), columnBytes);
+        writeAt(out, header.priorityOffset + columnOffset, priority.data(), columnBytes);
+        writeAt(out, header.deadlineOffset + columnOffset, deadline.data(), columnBytes);
+        writeAt(out, header.nameIndexOffset + (row + 1) * sizeof(uint64_t),
+                nameOffsets.data(), rows * sizeof(uint64_t));
+        writeAt(out, header.namesOffset + nameStart, names.data(), names.size());
+        row += rows;
+    }
+    
+    if (!out) {
+        throw runtime_error("Failed to write file: " + filePath);
+    }
+}
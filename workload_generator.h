@@ -0,0 +1,190 @@
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+#include "process.h"
+#include "process_table.h"
+#include "arrival_source.h"
+
+using namespace std;
+
+/**
+ * @enum ArrivalModel
+ * @brief How inter-arrival gaps are drawn
+ */
+enum ArrivalModel {
+    POISSON_ARRIVALS,  // Exponential gaps at a constant rate
+    MMPP_ARRIVALS      // Two-state Markov-modulated Poisson process: calm and bursty periods
+};
+
+/**
+ * @enum BurstModel
+ * @brief How burst times are drawn
+ */
+enum BurstModel {
+    UNIFORM_BURSTS,    // Uniform on [minBurst, maxBurst]
+    PARETO_BURSTS,     // Pareto with scale minBurst and shape paretoShape
+    LOGNORMAL_BURSTS   // exp(N(lognormalMu, lognormalSigma^2))
+};
+
+/**
+ * @struct WorkloadSpec
+ * @brief Parameters of a synthetic workload
+ * 
+ * Continuous draws are rounded to whole time units: arrival times down,
+ * burst times up and then clamped to [1, maxBurst].
+ */
+struct WorkloadSpec {
+    uint64_t jobs;                    // Number of processes to generate
+    uint64_t seed;                    // Seed; equal specs give identical workloads
+    
+    ArrivalModel arrivals;            // Arrival process
+    double arrivalRate;               // Poisson rate, or the MMPP calm-state rate (jobs per time unit)
+    double burstArrivalRate;          // MMPP bursty-state rate
+    double meanCalmTime;              // MMPP mean time spent in the calm state
+    double meanBurstyTime;            // MMPP mean time spent in the bursty state
+    
+    BurstModel bursts;                // Burst time distribution
+    int minBurst;                     // Smallest uniform burst, and the Pareto scale
+    int maxBurst;                     // Largest burst; heavier tails are clamped here
+    double paretoShape;               // Pareto tail index (alpha)
+    double lognormalMu;               // Mean of the underlying normal
+    double lognormalSigma;            // Standard deviation of the underlying normal
+    
+    vector<double> priorityWeights;   // Relative weight of priority level i
+    double deadlineFraction;          // Share of processes that get a deadline
+    double minDeadlineSlack;          // Deadline = arrival + burst * slack, slack uniform on
+    double maxDeadlineSlack;          // [minDeadlineSlack, maxDeadlineSlack]
+    
+    /**
+     * @brief Constructor for WorkloadSpec
+     * 
+     * Defaults to 1000 Poisson arrivals at rate 0.09 with uniform bursts
+     * on [1, 19] (offered load 0.9), priorities 0-9 with equal weight and
+     * no deadlines.
+     */
+    WorkloadSpec();
+    
+    /**
+     * @brief Checks that the parameters describe a valid workload
+     * 
+     * Throws invalid_argument naming the first bad parameter.
+     */
+    void validate() const;
+    
+    /**
+     * @brief Applies one workload command-line option, such as "--jobs"
+     * @param option Option name
+     * @param value Option value
+     * @return False if the option is not a workload option
+     * 
+     * Throws invalid_argument for a malformed value.
+     */
+    bool parseOption(const string& option, const string& value);
+    
+    /**
+     * @brief Writes one help line per workload option
+     * @param out Stream to write to
+     */
+    static void printOptions(ostream& out);
+};
+
+/**
+ * @class WorkloadGenerator
+ * @brief Seeded, streaming generator of synthetic workloads
+ * 
+ * Produces processes one at a time in arrival order, so a workload of any
+ * size can be fed straight into Scheduler::runStreaming() or written to a
+ * file without being held in memory. Random numbers come from a
+ * xoshiro256** stream and every distribution is sampled by hand, so a
+ * seed yields the same workload with any standard library. Processes are
+ * named P1, P2, ... in arrival order.
+ */
+class WorkloadGenerator : public ArrivalSource {
+private:
+    WorkloadSpec spec;              // Parameters being generated
+    uint64_t state[4];              // xoshiro256** state
+    uint64_t produced;              // Processes generated so far
+    double clock;                   // Continuous arrival time of the next process
+    long long workEnd;              // Time at which one CPU would finish the processes so far
+    bool bursty;                    // Current MMPP state
+    double stateEnd;                // Time at which the MMPP state next changes
+    vector<uint64_t> priorityThreshold;  // Alias table: chance (out of 2^32) of keeping level i
+    vector<int> priorityAlias;           // Alias table: level drawn instead of i
+    
+    uint64_t nextRandom();
+    double uniform();
+    double exponential(double rate);
+    double normal();
+    void advanceClock();
+    int drawBurst();
+    int drawPriority();
+
+public:
+    /**
+     * @brief Constructor for WorkloadGenerator
+     * @param spec Workload parameters; throws invalid_argument if they are invalid
+     */
+    explicit WorkloadGenerator(const WorkloadSpec& spec);
+    
+    /**
+     * @brief Generates the next row without building a Process
+     * @param arrival Receives the arrival time
+     * @param burst Receives the burst time
+     * @param priority Receives the priority
+     * @param deadline Receives the deadline, 0 if none
+     * @return False once spec.jobs rows have been generated
+     */
+    bool nextRow(int& arrival, int& burst, int& priority, int& deadline);
+    
+    /**
+     * @brief Generates the next process
+     * @param process Receives the process
+     * @return False once spec.jobs processes have been generated
+     */
+    bool next(Process& process) override;
+    
+    /**
+     * @brief Gets the number of processes generated so far
+     * @return Process count
+     */
+    uint64_t count() const;
+    
+    /**
+     * @brief Generates the whole workload into a process table
+     * @param spec Workload parameters
+     * @return Table with one row per process
+     */
+    static ProcessTable generateTable(const WorkloadSpec& spec);
+    
+    /**
+     * @brief Derives the seed of one of many independent streams
+     * @param seed Base seed
+     * @param stream Stream number
+     * @return Seed of that stream; different streams give unrelated workloads
+     */
+    static uint64_t streamSeed(uint64_t seed, uint64_t stream);
+    
+    /**
+     * @brief Streams a workload to a CSV file
+     * @param spec Workload parameters
+     * @param filePath Path of the file to create
+     */
+    static void writeCsv(const WorkloadSpec& spec, const string& filePath);
+    
+    /**
+     * @brief Streams a workload to a binary workload file (see WorkloadFile)
+     * @param spec Workload parameters
+     * @param filePath Path of the file to create
+     * 
+     * Every section's size is known from the job count, so rows are written
+     * in fixed-size chunks straight to their place in each column.
+     */
+    static void writeBinary(const WorkloadSpec& spec, const string& filePath);
+};
+
+#endif // WORKLOAD_GENERATOR_H